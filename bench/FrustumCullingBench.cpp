@@ -0,0 +1,99 @@
+#include "Math/AABB.h"
+#include "Math/Frustum.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Tristeon;
+
+#if defined(__AVX__)
+static const char* instructionSet = "AVX";
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+static const char* instructionSet = "SSE";
+#else
+static const char* instructionSet = "scalar";
+#endif
+
+/**
+ * Runs test until at least 0.2 seconds have passed and returns the amount of boxes tested per second
+ */
+template <typename F>
+double measure(F test, size_t boxCount)
+{
+	//Warm up
+	test();
+
+	size_t runs = 0;
+	auto const start = std::chrono::high_resolution_clock::now();
+	auto end = start;
+	do
+	{
+		test();
+		runs++;
+		end = std::chrono::high_resolution_clock::now();
+	} while (std::chrono::duration<double>(end - start).count() < 0.2);
+	return (double)(runs * boxCount) / std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+	//Boxes scattered around a camera that sees roughly a sixth of them
+	glm::mat4 const view = glm::lookAt(glm::vec3(0, 10, 0), glm::vec3(0, 0, 100), glm::vec3(0, 1, 0));
+	glm::mat4 const proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.3f, 1000.0f);
+	Math::Frustum const frustum(view, proj);
+
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> position(-500, 500);
+	std::uniform_real_distribution<float> size(0.5f, 5);
+
+	size_t const boxCounts[] = { 1000, 10000, 100000, 1000000 };
+
+	printf("kernel: %s\n", instructionSet);
+	printf("%-10s %-10s %-20s %-20s %-8s\n", "boxes", "visible", "scalar Mboxes/s", "batch Mboxes/s", "speedup");
+	for (size_t const count : boxCounts)
+	{
+		std::vector<Math::AABB> boxes;
+		Math::AABBArray array;
+		boxes.reserve(count);
+		array.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			glm::vec3 const center(position(random), position(random) * 0.1f, position(random));
+			glm::vec3 const extents(size(random), size(random), size(random));
+			boxes.push_back(Math::AABB(center - extents, center + extents));
+			array.add(boxes.back());
+		}
+
+		std::vector<uint8_t> scalarResults(count);
+		std::vector<uint8_t> batchResults(count);
+		volatile size_t visible = 0;
+
+		double const scalar = measure([&]()
+		{
+			size_t v = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				scalarResults[i] = frustum.intersects(boxes[i]) ? 1 : 0;
+				v += scalarResults[i];
+			}
+			visible = v;
+		}, count);
+
+		double const batch = measure([&]()
+		{
+			visible = frustum.intersects(array, batchResults.data());
+		}, count);
+
+		if (scalarResults != batchResults)
+		{
+			printf("The batch kernel doesn't match the scalar test for %zu boxes\n", count);
+			return 1;
+		}
+
+		printf("%-10zu %-10zu %-20.1f %-20.1f %-8.2f\n", count, (size_t)visible, scalar / 1e6, batch / 1e6, batch / scalar);
+	}
+	return 0;
+}
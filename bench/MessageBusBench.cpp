@@ -0,0 +1,81 @@
+#include "Core/MessageBus.h"
+#include "Misc/Delegate.h"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+using namespace Tristeon;
+using namespace Tristeon::Core;
+
+/**
+ * The MessageBus as it was before dispatch moved to a flat array, kept here as a reference point:
+ * a std::map of Delegates, messages and callbacks by value.
+ */
+class LegacyMessageBus
+{
+public:
+	static void sendMessage(Message message)
+	{
+		validateMessageType(message.type);
+		messageCallbacks[message.type].invoke(message);
+	}
+
+	static void subscribeToMessage(MessageType type, std::function<void(Message)> f)
+	{
+		validateMessageType(type);
+		messageCallbacks[type] += f;
+	}
+
+private:
+	static void validateMessageType(MessageType type)
+	{
+		if (!messageCallbacks.count(type))
+			messageCallbacks[type] = Misc::Delegate<Message>();
+	}
+
+	static std::map<MessageType, Misc::Delegate<Message>> messageCallbacks;
+};
+std::map<MessageType, Misc::Delegate<Message>> LegacyMessageBus::messageCallbacks;
+
+/**
+ * Returns the average time in nanoseconds it takes to call send(type)
+ */
+template <typename F>
+double measure(F send, MessageType type, size_t iterations)
+{
+	//Warm up
+	for (size_t i = 0; i < iterations / 10; i++)
+		send(type);
+
+	auto const start = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+		send(type);
+	auto const end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main()
+{
+	//Every run uses its own message type so subscribers don't accumulate.
+	//The lookup and copies are a fixed cost per message, with many subscribers the calls themselves dominate and both buses converge
+	MessageType const types[] = { MT_UPDATE, MT_LATEUPDATE, MT_FIXEDUPDATE };
+	size_t const subscriberCounts[] = { 1, 10, 100 };
+
+	volatile size_t calls = 0;
+	printf("%-12s %-16s %-16s\n", "subscribers", "legacy ns/msg", "flat ns/msg");
+	for (size_t run = 0; run < 3; run++)
+	{
+		for (size_t i = 0; i < subscriberCounts[run]; i++)
+		{
+			LegacyMessageBus::subscribeToMessage(types[run], [&](Message) { calls = calls + 1; });
+			MessageBus::subscribeToMessage(types[run], [&](const Message&) { calls = calls + 1; });
+		}
+
+		size_t const iterations = 2000000 / subscriberCounts[run];
+		double const legacy = measure([](MessageType t) { LegacyMessageBus::sendMessage(t); }, types[run], iterations);
+		double const flat = measure([](MessageType t) { MessageBus::sendMessage(t); }, types[run], iterations);
+		printf("%-12zu %-16.1f %-16.1f\n", subscriberCounts[run], legacy, flat);
+	}
+	return 0;
+}
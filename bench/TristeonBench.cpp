@@ -0,0 +1,538 @@
+#include "Core/Engine.h"
+#include "Core/GameObject.h"
+#include "Core/Transform.h"
+#include "Core/MessageBus.h"
+#include "Core/UserPrefs.h"
+#include "Core/Components/Component.h"
+#include "Core/Rendering/ShaderFile.h"
+#include "Core/Rendering/Components/Renderer.h"
+#include "Scenes/Scene.h"
+#include "Scenes/BinaryScene.h"
+#include "Data/Mesh.h"
+#include "Data/ImageBatch.h"
+#include "Editor/TypeRegister.h"
+#include "Misc/Delegate.h"
+#include "Misc/Console.h"
+#include "Misc/vector.h"
+#include "Misc/ObjectPool.h"
+#include "Misc/Hardware/Time.h"
+
+#include <boost/filesystem.hpp>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <set>
+
+namespace filesystem = boost::filesystem;
+using namespace Tristeon;
+
+/**
+ * A component that does a tiny bit of work every update, used to measure the cost of ticking components
+ */
+class TickComponent : public Core::Components::Component
+{
+public:
+	void update() override { value += Misc::Time::getDeltaTime(); }
+
+	nlohmann::json serialize() override
+	{
+		nlohmann::json output;
+		output["typeID"] = TRISTEON_TYPENAME(TickComponent);
+		output["value"] = value;
+		return output;
+	}
+
+	void deserialize(nlohmann::json json) override
+	{
+		value = json["value"];
+	}
+
+	float value = 0;
+private:
+	REGISTER_TYPE_H(TickComponent)
+};
+REGISTER_TYPE_CPP(TickComponent)
+
+/**
+ * TickComponent with its update declared safe to run in parallel
+ */
+class ParallelTickComponent : public TickComponent
+{
+public:
+	static const uint8_t parallelCallbacks = Core::Components::CC_UPDATE;
+
+	nlohmann::json serialize() override
+	{
+		nlohmann::json output = TickComponent::serialize();
+		output["typeID"] = TRISTEON_TYPENAME(ParallelTickComponent);
+		return output;
+	}
+private:
+	REGISTER_TYPE_H(ParallelTickComponent)
+};
+REGISTER_TYPE_CPP(ParallelTickComponent)
+
+/**
+ * A renderer without an internal renderer, used to measure the cost of (de)registering renderers
+ */
+class EmptyRenderer : public Core::Rendering::Renderer
+{
+public:
+	void initInternalRenderer() override { }
+};
+
+/**
+ * Runs benchmarks and collects their results.
+ * Every benchmark runs a number of samples, each sample calls the benchmark function until minSampleTime has passed.
+ * The benchmark function returns the amount of operations it did, results are reported in nanoseconds per operation.
+ */
+class Benchmarks
+{
+public:
+	Benchmarks(std::string filter, double minSampleTime, int samples) : filter(filter), minSampleTime(minSampleTime), samples(samples) { }
+
+	/**
+	 * Returns true if the benchmark with the given name passes the filter
+	 */
+	bool enabled(const std::string& name) const { return filter.empty() || name.find(filter) != std::string::npos; }
+
+	/**
+	 * Measures f, reported as name with the given size. The meaning of size depends on the benchmark (depth, count, etc.)
+	 */
+	template <typename F>
+	void run(const std::string& name, size_t size, F f)
+	{
+		if (!enabled(name))
+			return;
+
+		//Warm up caches and lazily created data
+		f();
+
+		std::vector<double> times;
+		size_t totalOperations = 0;
+		for (int i = 0; i < samples; i++)
+		{
+			size_t operations = 0;
+			auto const start = std::chrono::steady_clock::now();
+			double elapsed = 0;
+			do
+			{
+				operations += f();
+				elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			} while (elapsed < minSampleTime * 1e9);
+
+			times.push_back(elapsed / operations);
+			totalOperations += operations;
+		}
+		std::sort(times.begin(), times.end());
+
+		nlohmann::json result;
+		result["name"] = name;
+		result["size"] = size;
+		result["operations"] = totalOperations;
+		result["median"] = times[times.size() / 2];
+		result["min"] = times.front();
+		result["max"] = times.back();
+		results.push_back(result);
+
+		printf("%-48s %8zu %14.1f %14.1f\n", name.c_str(), size, times[times.size() / 2], times.front());
+	}
+
+	/**
+	 * Returns all results and the settings they were measured with
+	 */
+	nlohmann::json toJson() const
+	{
+		nlohmann::json output;
+		output["unit"] = "ns";
+		output["samples"] = samples;
+		output["minSampleTime"] = minSampleTime;
+#ifdef NDEBUG
+		output["configuration"] = "Release";
+#else
+		output["configuration"] = "Debug";
+#endif
+#ifdef TRISTEON_PROFILE
+		output["profiling"] = true;
+#else
+		output["profiling"] = false;
+#endif
+		output["benchmarks"] = results;
+		return output;
+	}
+private:
+	std::string filter;
+	double minSampleTime;
+	int samples;
+	nlohmann::json results = nlohmann::json::array();
+};
+
+/**
+ * Serializes a scene with count GameObjects that each have a TickComponent (or ParallelTickComponent)
+ */
+nlohmann::json createSceneData(size_t count, bool parallel)
+{
+	nlohmann::json gameObjects = nlohmann::json::array();
+	for (size_t i = 0; i < count; i++)
+	{
+		Core::GameObject gameObject;
+		gameObject.name = "GameObject" + std::to_string(i);
+		gameObject.transform.get()->localPosition = Math::Vector3((float)(i % 100), 0, (float)(i / 100));
+		if (parallel)
+			gameObject.addComponent<ParallelTickComponent>();
+		else
+			gameObject.addComponent<TickComponent>();
+		gameObjects.push_back(gameObject.serialize());
+	}
+
+	nlohmann::json output;
+	output["typeID"] = TRISTEON_TYPENAME(Scenes::Scene);
+	output["name"] = "Benchmark";
+	output["gameObjects"] = gameObjects;
+	return output;
+}
+
+/**
+ * Writes a UV sphere with the given amount of segments to an .obj file
+ */
+void writeSphere(const std::string& path, int segments)
+{
+	std::ofstream file(path);
+	int const rings = segments / 2;
+	for (int ring = 0; ring <= rings; ring++)
+	{
+		float const theta = glm::pi<float>() * ring / rings;
+		for (int segment = 0; segment <= segments; segment++)
+		{
+			float const phi = glm::two_pi<float>() * segment / segments;
+			float const x = sin(theta) * cos(phi), y = cos(theta), z = sin(theta) * sin(phi);
+			file << "v " << x << " " << y << " " << z << "\n";
+			file << "vn " << x << " " << y << " " << z << "\n";
+			file << "vt " << (float)segment / segments << " " << (float)ring / rings << "\n";
+		}
+	}
+
+	for (int ring = 0; ring < rings; ring++)
+	{
+		for (int segment = 0; segment < segments; segment++)
+		{
+			//Obj indices are 1 based
+			int const a = ring * (segments + 1) + segment + 1;
+			int const b = a + segments + 1;
+			file << "f " << a << "/" << a << "/" << a << " " << b << "/" << b << "/" << b << " " << b + 1 << "/" << b + 1 << "/" << b + 1 << "\n";
+			file << "f " << a << "/" << a << "/" << a << " " << b + 1 << "/" << b + 1 << "/" << b + 1 << " " << a + 1 << "/" << a + 1 << "/" << a + 1 << "\n";
+		}
+	}
+}
+
+void benchTransforms(Benchmarks& bench)
+{
+	for (size_t const depth : { 1, 4, 16, 64 })
+	{
+		//A chain of transforms, depth deep
+		std::vector<std::unique_ptr<Core::GameObject>> chain;
+		for (size_t i = 0; i < depth; i++)
+		{
+			chain.push_back(std::make_unique<Core::GameObject>());
+			Core::Transform* t = chain.back()->transform.get();
+			t->localPosition = Math::Vector3(1, 0, 0);
+			t->localRotation = Math::Quaternion::euler(Math::Vector3(0, 10, 0));
+			if (i > 0)
+				t->setParent(chain[i - 1]->transform.get(), false);
+		}
+		Core::Transform* root = chain.front()->transform.get();
+		Core::Transform* leaf = chain.back()->transform.get();
+
+		float offset = 0;
+		glm::mat4 matrix;
+		Math::Vector3 position;
+		Math::Quaternion rotation;
+
+		bench.run("Transform.getTransformationMatrix/cached", depth, [&]() { matrix = leaf->getTransformationMatrix(); return 1; });
+		bench.run("Transform.getTransformationMatrix/dirty", depth, [&]()
+		{
+			root->localPosition = Math::Vector3(offset += 0.001f, 0, 0);
+			matrix = leaf->getTransformationMatrix();
+			return 1;
+		});
+		bench.run("Transform.getGlobalPosition/dirty", depth, [&]()
+		{
+			root->localPosition = Math::Vector3(offset += 0.001f, 0, 0);
+			position = leaf->position.get();
+			return 1;
+		});
+		bench.run("Transform.getGlobalRotation/dirty", depth, [&]()
+		{
+			root->localPosition = Math::Vector3(offset += 0.001f, 0, 0);
+			rotation = leaf->rotation.get();
+			return 1;
+		});
+
+		//Children first, so that no transform outlives its parent
+		while (!chain.empty())
+			chain.pop_back();
+	}
+}
+
+void benchMessageBus(Benchmarks& bench)
+{
+	//MT_SHARE_DATA is only used by the editor, which doesn't exist in the benchmark. Subscribers can't be removed, so they are added up to each count
+	size_t received = 0;
+	size_t subscribers = 0;
+	for (size_t const count : { 1, 8, 64 })
+	{
+		for (; subscribers < count; subscribers++)
+			Core::MessageBus::subscribeToMessage(Core::MT_SHARE_DATA, [&](const Core::Message&) { received++; });
+
+		bench.run("MessageBus.sendMessage", count, [&]() { Core::MessageBus::sendMessage(Core::MT_SHARE_DATA); return 1; });
+	}
+}
+
+void benchRendering(Benchmarks& bench)
+{
+	for (size_t const count : { 1000, 10000, 100000 })
+	{
+		if (!bench.enabled("RenderManager.registerDeregister"))
+			break;
+
+		std::vector<std::unique_ptr<EmptyRenderer>> renderers;
+		for (size_t i = 0; i < count; i++)
+			renderers.push_back(std::make_unique<EmptyRenderer>());
+
+		//Deregisters in the order of registration, like a scene that is unloaded
+		bench.run("RenderManager.registerDeregister", count, [&]()
+		{
+			for (const auto& r : renderers)
+				Core::MessageBus::sendMessage({ Core::MT_RENDERINGCOMPONENT_REGISTER, r.get() });
+			for (const auto& r : renderers)
+				Core::MessageBus::sendMessage({ Core::MT_RENDERINGCOMPONENT_DEREGISTER, r.get() });
+			return count;
+		});
+	}
+}
+
+void benchComponents(Benchmarks& bench)
+{
+	for (size_t const count : { 1000, 10000, 100000 })
+	{
+		if (bench.enabled("ComponentManager.update/serial"))
+		{
+			Scenes::Scene scene;
+			scene.deserialize(createSceneData(count, false));
+			bench.run("ComponentManager.update/serial", count, [&]() { Core::MessageBus::sendMessage(Core::MT_UPDATE); return 1; });
+		}
+
+		if (bench.enabled("ComponentManager.update/parallel"))
+		{
+			Scenes::Scene scene;
+			scene.deserialize(createSceneData(count, true));
+			bench.run("ComponentManager.update/parallel", count, [&]() { Core::MessageBus::sendMessage(Core::MT_UPDATE); return 1; });
+		}
+	}
+}
+
+void benchSerialization(Benchmarks& bench)
+{
+	for (size_t const count : { 1, 8 })
+	{
+		Core::GameObject gameObject;
+		for (size_t i = 0; i < count; i++)
+			gameObject.addComponent<TickComponent>();
+
+		bench.run("GameObject.serialize", count, [&]() { nlohmann::json const j = gameObject.serialize(); return 1; });
+		bench.run("GameObject.roundTrip", count, [&]() { gameObject.deserialize(gameObject.serialize()); return 1; });
+	}
+
+	for (size_t const count : { 100, 1000, 10000 })
+	{
+		if (!bench.enabled("Scene."))
+			continue;
+
+		Scenes::Scene scene;
+		scene.deserialize(createSceneData(count, false));
+
+		bench.run("Scene.serialize", count, [&]() { nlohmann::json const j = scene.serialize(); return 1; });
+		bench.run("Scene.roundTrip", count, [&]()
+		{
+			//Through text, as scenes are stored on disk
+			std::string const text = scene.serialize().dump();
+			Scenes::Scene loaded;
+			loaded.deserialize(nlohmann::json::parse(text));
+			return 1;
+		});
+	}
+
+	filesystem::path const directory = filesystem::temp_directory_path() / filesystem::unique_path();
+	filesystem::create_directories(directory);
+	for (size_t const count : { 100, 1000, 10000 })
+	{
+		if (!bench.enabled("BinaryScene."))
+			break;
+
+		nlohmann::json const data = createSceneData(count, false);
+		std::string const path = (directory / ("scene" + std::to_string(count) + ".bin")).string();
+		Scenes::BinaryScene::write(data, path);
+
+		//Removing a GameObject moves the last one into its place, which has to be set up correctly for binary scenes too
+		std::unique_ptr<Scenes::Scene> scene(Scenes::BinaryScene::load(path));
+		Misc::Console::t_assert(scene != nullptr, "BinaryScene.load couldn't load " + path);
+		const std::string middleID = data["gameObjects"][count / 2]["instanceID"];
+		scene->removeGameObject(scene->getGameObject(middleID));
+		nlohmann::json const loaded = scene->serialize();
+		std::set<std::string> remaining;
+		for (const nlohmann::json& gameObject : loaded["gameObjects"])
+		{
+			const std::string id = gameObject["instanceID"];
+			if (scene->getHandle(Core::TObject::parseInstanceID(id)) != 0)
+				remaining.insert(id);
+		}
+		bool removed = remaining.size() == count - 1 && remaining.count(middleID) == 0;
+		for (const nlohmann::json& gameObject : data["gameObjects"])
+		{
+			const std::string id = gameObject["instanceID"];
+			removed = removed && (id == middleID || remaining.count(id) == 1);
+		}
+		Misc::Console::t_assert(removed, "Scene.removeGameObject removed the wrong GameObject from a binary scene");
+		scene.reset();
+
+		bench.run("BinaryScene.load", count, [&]() { std::unique_ptr<Scenes::Scene> const loaded(Scenes::BinaryScene::load(path)); return 1; });
+	}
+	filesystem::remove_all(directory);
+}
+
+void benchData(Benchmarks& bench)
+{
+	//Meshes are generated, so that every run loads exactly the same data
+	filesystem::path const directory = filesystem::temp_directory_path() / filesystem::unique_path();
+	filesystem::create_directories(directory);
+	for (int const segments : { 16, 64, 256 })
+	{
+		std::string const path = (directory / ("sphere" + std::to_string(segments) + ".obj")).string();
+		writeSphere(path, segments);
+		bench.run("Mesh.load", segments, [&]() { Data::Mesh mesh; mesh.load(path); return 1; });
+	}
+	filesystem::remove_all(directory);
+
+	for (std::string const path : { "Files/Textures/white.jpg", "Files/Textures/texture.jpg", "Files/Textures/doge.png" })
+	{
+		if (!filesystem::exists(path))
+		{
+			Misc::Console::warning("Skipping ImageBatch.load, " + path + " doesn't exist. TristeonBench has to run from the bin folder.");
+			continue;
+		}
+
+		Data::ImageBatch::load(path);
+		Data::Image const image = Data::ImageBatch::getImage(path);
+		bench.run("ImageBatch.load/" + filesystem::path(path).filename().string(), (size_t)(image.getWidth() * image.getHeight()), [&]() { Data::ImageBatch::load(path); return 1; });
+		Data::ImageBatch::unload(path);
+	}
+
+	Core::Rendering::ShaderFile const shader("Standard", "Files/Shaders/", "StandardV", "StandardF");
+	if (!filesystem::exists(shader.getPath("NULL", Core::Rendering::ST_Vertex)) || !filesystem::exists(shader.getPath("NULL", Core::Rendering::ST_Fragment)))
+		Misc::Console::warning("Skipping ShaderFile.getProps, the Standard shader doesn't exist. TristeonBench has to run from the bin folder.");
+	else
+	{
+		//Properties are cached by the shader file, every operation reflects a fresh copy
+		bench.run("ShaderFile.getProps", 1, [&]() { Core::Rendering::ShaderFile file = shader; file.getProps(); return 1; });
+	}
+}
+
+void benchContainers(Benchmarks& bench)
+{
+	size_t calls = 0;
+	for (size_t const count : { 1, 8, 64 })
+	{
+		Misc::Delegate<int> delegate;
+		for (size_t i = 0; i < count; i++)
+			delegate += [&](int value) { calls += value; };
+		bench.run("Delegate.invoke", count, [&]() { delegate.invoke(1); return 1; });
+	}
+
+	for (size_t const count : { 16, 256, 4096, 65536 })
+	{
+		Tristeon::vector<uint32_t> values;
+		for (uint32_t i = 0; i < count; i++)
+			values.push_back(i);
+
+		//Removes the element in the middle and adds it back at the end, so that the size stays the same
+		bench.run("vector.remove", count, [&]()
+		{
+			uint32_t const value = values[values.size() / 2];
+			values.remove(value);
+			values.push_back(value);
+			return 1;
+		});
+	}
+
+	//A burst of count spawns that is cleaned up again, in reverse order so that the pools can't rely on FIFO order
+	struct PoolObject { Math::Vector3 position; float lifetime = 0; };
+	for (size_t const count : { 16, 256, 4096 })
+	{
+		std::vector<PoolObject*> objects(count);
+		ObjectPool<PoolObject*> pool;
+		bench.run("ObjectPool.getRelease", count, [&]()
+		{
+			for (size_t i = 0; i < count; i++)
+				objects[i] = pool.get();
+			for (size_t i = count; i > 0; i--)
+				pool.release(objects[i - 1]);
+			return count;
+		});
+
+		std::vector<HandlePool<PoolObject>::Handle> handles(count);
+		HandlePool<PoolObject> handlePool;
+		bench.run("HandlePool.createDestroy", count, [&]()
+		{
+			for (size_t i = 0; i < count; i++)
+				handles[i] = handlePool.create();
+			for (size_t i = count; i > 0; i--)
+				handlePool.destroy(handles[i - 1]);
+			return count;
+		});
+	}
+}
+
+/**
+ * Runs the engine's microbenchmarks on a headless engine and writes the results to a JSON file.
+ *
+ * Takes the engine's command line settings, and:
+ * --OUT=path			The file to write the results to, TristeonBench.json by default
+ * --FILTER=text		Only runs the benchmarks whose name contains text
+ * --SAMPLES=n			The amount of samples per benchmark, 5 by default. The median is reported
+ * --SAMPLETIME=s		The minimum duration of a sample in seconds, 0.05 by default
+ *
+ * The data benchmarks load the engine's files and have to run from the bin folder.
+ */
+int main(int argc, char** argv)
+{
+	//The benchmarks always run headless, settings passed on the command line come after so that they can still override it
+	std::vector<char*> arguments(argv, argv + argc);
+	char api[] = "--RENDERAPI=NULL";
+	arguments.insert(arguments.begin() + (argc > 0 ? 1 : 0), api);
+
+	std::unique_ptr<Core::Engine> engine = std::make_unique<Core::Engine>((int)arguments.size(), arguments.data());
+
+	std::string const out = Core::UserPrefs::hasString("OUT") ? Core::UserPrefs::getStringValue("OUT") : "TristeonBench.json";
+	int const samples = Core::UserPrefs::hasString("SAMPLES") ? std::max(1, std::stoi(Core::UserPrefs::getStringValue("SAMPLES"))) : 5;
+	double const sampleTime = Core::UserPrefs::hasString("SAMPLETIME") ? std::stod(Core::UserPrefs::getStringValue("SAMPLETIME")) : 0.05;
+	Benchmarks bench(Core::UserPrefs::getStringValue("FILTER"), sampleTime, samples);
+
+	printf("%-48s %8s %14s %14s\n", "benchmark", "size", "median ns/op", "min ns/op");
+	benchTransforms(bench);
+	benchMessageBus(bench);
+	benchComponents(bench);
+	benchRendering(bench);
+	benchSerialization(bench);
+	benchData(bench);
+	benchContainers(bench);
+
+	std::ofstream file(out);
+	file << bench.toJson().dump(4);
+	printf("Results written to %s\n", out.c_str());
+
+	//Everything that the benchmarks created is gone, the engine can safely shut down
+	engine.reset();
+	return 0;
+}
@@ -21,14 +21,21 @@ namespace Tristeon
 			void Camera::init()
 			{
 				if (!registered)
-					MessageBus::sendMessage({ MT_CAMERA_REGISTER, this });
+					MessageBus::sendBatchable({ MT_CAMERA_REGISTER, this });
 				Component::init();
 			}
 
+			void Camera::deinit()
+			{
+				if (registered && !MessageBus::cancelBatched({ MT_CAMERA_REGISTER, this }))
+					MessageBus::sendMessage({ MT_CAMERA_DEREGISTER, this });
+				Component::deinit();
+			}
+
 			Camera::~Camera()
 			{
 				//Deregister
-				if (registered)
+				if (registered && !MessageBus::cancelBatched({ MT_CAMERA_REGISTER, this }))
 					MessageBus::sendMessage({ MT_CAMERA_DEREGISTER, this });
 			}
 
@@ -53,6 +60,11 @@ namespace Tristeon
 				return glm::perspective<float>(glm::radians(fov), aspect, nearClippingPlane, farClippingPlane);
 			}
 
+			Math::Frustum Camera::getFrustum(float aspect)
+			{
+				return Math::Frustum(getViewMatrix(), getProjectionMatrix(aspect));
+			}
+
 			glm::mat4 Camera::getViewMatrix(Transform* t)
 			{
 				//Get parent matrix
@@ -3,11 +3,14 @@
 #include <glm/mat4x3.hpp>
 #include "Editor/TypeRegister.h"
 #include "Core/Rendering/Skybox.h"
+#include "Math/Frustum.h"
 
 namespace Tristeon
 {
 	namespace Core
 	{
+		namespace Rendering { class RenderManager; }
+
 		namespace Components
 		{
 			/**
@@ -15,11 +18,16 @@ namespace Tristeon
 			 */
 			class Camera : public Component
 			{
+				friend Rendering::RenderManager;
 			public:
 				/**
 				 * Initializes the camera and registers the camera to the rendering system
 				 */
 				void init() override;
+				/**
+				 * Deregisters the camera from the rendering system
+				 */
+				void deinit() override;
 				/**
 				 * Deregisters the camera
 				 */
@@ -48,6 +56,12 @@ namespace Tristeon
 				 * \return The projection matrix
 				 */
 				glm::mat4 getProjectionMatrix(float aspect) const;
+				/**
+				 * Returns the view frustum of this camera, extracted from its view and projection matrix
+				 * \param aspect The aspect ratio of the screen
+				 * \return The view frustum
+				 */
+				Math::Frustum getFrustum(float aspect);
 
 				/**
 				 * Returns the view matrix based on transform t
@@ -71,6 +85,10 @@ namespace Tristeon
 			private:
 				std::string skyboxPath = "";
 				Rendering::Skybox* skybox = nullptr;
+				/**
+				 * The index of the camera in the render manager's camera registry
+				 */
+				uint32_t registryIndex = UINT32_MAX;
 
 				REGISTER_TYPE_H(Camera)
 			};
@@ -10,7 +10,7 @@ namespace Tristeon
 		{
 			Component::~Component()
 			{
-				if (registered)
+				if (registered && !MessageBus::cancelBatched({ MT_SCRIPTINGCOMPONENT_REGISTER, this }))
 					MessageBus::sendMessage({ MT_SCRIPTINGCOMPONENT_DEREGISTER, this });
 			}
 
@@ -22,10 +22,17 @@ namespace Tristeon
 			void Component::init()
 			{
 				if (!registered)
-					MessageBus::sendMessage({ MT_SCRIPTINGCOMPONENT_REGISTER, this });
+					MessageBus::sendBatchable({ MT_SCRIPTINGCOMPONENT_REGISTER, this });
 				registered = true;
 			}
 
+			void Component::deinit()
+			{
+				if (registered && !MessageBus::cancelBatched({ MT_SCRIPTINGCOMPONENT_REGISTER, this }))
+					MessageBus::sendMessage({ MT_SCRIPTINGCOMPONENT_DEREGISTER, this });
+				registered = false;
+			}
+
 			void Component::setup(GameObject* go)
 			{
 				_gameObject = go;
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "Core/TObject.h"
 #include "Misc/Property.h"
+#include "ComponentTypes.h"
 
 namespace Tristeon
 {
@@ -12,12 +13,19 @@ namespace Tristeon
 
 		namespace Components
 		{
+			class ComponentPool;
+			class ComponentManager;
+			struct ComponentDeleter;
+
 			/**
 			 * Component is the base class of all components in the engine. A component is a piece of behavior that can be added to a gameobject.
 			 */
 			class Component : public TObject
 			{
 				friend GameObject;
+				friend ComponentPool;
+				friend ComponentManager;
+				friend ComponentDeleter;
 
 			public:
 				/**
@@ -41,6 +49,10 @@ namespace Tristeon
 				 * Initializes the component and registers itself to engine callbacks. Can be overriden
 				 */
 				virtual void init();
+				/**
+				 * Deregisters the component from engine callbacks, undoing init(). Can be overriden, overrides must call the base
+				 */
+				virtual void deinit();
 
 				/**
 				 * Start gets called when the scene is first run
@@ -58,6 +70,15 @@ namespace Tristeon
 				 * LateUpdate gets called after all the other update calls
 				 */
 				virtual void lateUpdate() {}
+
+				/**
+				 * A combination of CC_UPDATE and CC_FIXEDUPDATE, declaring which callbacks are safe to run in parallel with other components.
+				 * Component types can hide this with their own value. Parallel callbacks run on worker threads before the serial ones,
+				 * and must only modify the component's own data. They can't send messages or add components.
+				 * Looking up components by a base type is only safe if that type was registered before the components were added,
+				 * which REGISTER_TYPE does at startup. Otherwise the first lookup fills a cache, call ComponentTypes::id<T>() on the main thread first.
+				 */
+				static const uint8_t parallelCallbacks = 0;
 			private:
 				/**
 				 * Stores the gameobject it's attached to. Only GameObject can call this function
@@ -68,6 +89,24 @@ namespace Tristeon
 				 * The gameobject this component is attached to
 				 */
 				GameObject* _gameObject = nullptr;
+
+				/**
+				 * The pool this component was created in and its slot in that pool. Nullptr if the component wasn't created in a pool.
+				 */
+				ComponentPool* pool = nullptr;
+				uint32_t poolIndex = 0;
+				/**
+				 * The ComponentTypes ID of the exact type of this component, assigned by its pool
+				 */
+				uint32_t componentType = ComponentTypes::unknownType;
+				/**
+				 * The indices of this component in ComponentManager's callback registries.
+				 * The serial and parallel lists of a callback share an index, a component is only ever in one of them.
+				 */
+				uint32_t startIndex = UINT32_MAX;
+				uint32_t updateIndex = UINT32_MAX;
+				uint32_t lateUpdateIndex = UINT32_MAX;
+				uint32_t fixedUpdateIndex = UINT32_MAX;
 			protected:
 				bool registered = false;
 			};
@@ -10,32 +10,65 @@ namespace Tristeon
 	{
 		namespace Components
 		{
-			ComponentManager::ComponentManager()
+			ComponentManager::ComponentManager() :
+				startComponents(&Component::startIndex),
+				updateComponents(&Component::updateIndex),
+				lateUpdateComponents(&Component::lateUpdateIndex),
+				fixedUpdateComponents(&Component::fixedUpdateIndex),
+				parallelUpdateComponents(&Component::updateIndex),
+				parallelFixedUpdateComponents(&Component::fixedUpdateIndex)
 			{
 				//Subscribe to message events regarding callbacks and (de)registering of components
-				MessageBus::subscribeToMessage(MT_SCRIPTINGCOMPONENT_REGISTER, [&](Message message) { registerComponent(message); });
-				MessageBus::subscribeToMessage(MT_SCRIPTINGCOMPONENT_DEREGISTER, [&](Message message) { deregisterComponent(message); });
-				MessageBus::subscribeToMessage(MT_START, [&](Message)       { callFunction<&Component::start>(); });
-				MessageBus::subscribeToMessage(MT_UPDATE, [&](Message)      { callFunction<&Component::update>(); });
-				MessageBus::subscribeToMessage(MT_LATEUPDATE, [&](Message)  { callFunction<&Component::lateUpdate>(); });
-				MessageBus::subscribeToMessage(MT_FIXEDUPDATE, [&](Message) { callFunction<&Component::fixedUpdate>(); });
+				MessageBus::subscribeToMessage(MT_SCRIPTINGCOMPONENT_REGISTER, [&](const Message& message) { registerComponent(message); });
+				MessageBus::subscribeToMessage(MT_SCRIPTINGCOMPONENT_DEREGISTER, [&](const Message& message) { deregisterComponent(message); });
+				MessageBus::subscribeToMessage(MT_START, [&](const Message&)       { callFunction<&Component::start>(startComponents); });
+				MessageBus::subscribeToMessage(MT_UPDATE, [&](const Message&)
+				{
+					callFunctionParallel<&Component::update>(parallelUpdateComponents);
+					callFunction<&Component::update>(updateComponents);
+				});
+				MessageBus::subscribeToMessage(MT_LATEUPDATE, [&](const Message&)  { callFunction<&Component::lateUpdate>(lateUpdateComponents); });
+				MessageBus::subscribeToMessage(MT_FIXEDUPDATE, [&](const Message&)
+				{
+					callFunctionParallel<&Component::fixedUpdate>(parallelFixedUpdateComponents);
+					callFunction<&Component::fixedUpdate>(fixedUpdateComponents);
+				});
 			}
 
-			void ComponentManager::registerComponent(Message msg)
+			void ComponentManager::registerComponent(const Message& msg)
 			{
 				Misc::Console::t_assert(msg.userData != nullptr, "Trying to register a null component!");
 				Component* c = dynamic_cast<Component*>(msg.userData);
 				Misc::Console::t_assert(c != nullptr, "Failed to cast userData to component!");
-				components.push_back(c);
+
+				uint8_t const callbacks = ComponentTypes::getCallbacks(c->componentType);
+				uint8_t const parallel = ComponentTypes::getParallelCallbacks(c->componentType);
+				if (callbacks & CC_START)
+					startComponents.add(c);
+				if (callbacks & CC_UPDATE)
+					(parallel & CC_UPDATE ? parallelUpdateComponents : updateComponents).add(c);
+				if (callbacks & CC_LATEUPDATE)
+					lateUpdateComponents.add(c);
+				if (callbacks & CC_FIXEDUPDATE)
+					(parallel & CC_FIXEDUPDATE ? parallelFixedUpdateComponents : fixedUpdateComponents).add(c);
 			}
 
-			void ComponentManager::deregisterComponent(Message msg)
+			void ComponentManager::deregisterComponent(const Message& msg)
 			{
 				Misc::Console::t_assert(msg.userData != nullptr, "Trying to register a null component!");
 				Component* c = dynamic_cast<Component*>(msg.userData);
 				Misc::Console::t_assert(c != nullptr, "Failed to cast userData to component!");
-				if (components.size() != 0)
-					components.remove(c);
+
+				uint8_t const callbacks = ComponentTypes::getCallbacks(c->componentType);
+				uint8_t const parallel = ComponentTypes::getParallelCallbacks(c->componentType);
+				if (callbacks & CC_START)
+					startComponents.remove(c);
+				if (callbacks & CC_UPDATE)
+					(parallel & CC_UPDATE ? parallelUpdateComponents : updateComponents).remove(c);
+				if (callbacks & CC_LATEUPDATE)
+					lateUpdateComponents.remove(c);
+				if (callbacks & CC_FIXEDUPDATE)
+					(parallel & CC_FIXEDUPDATE ? parallelFixedUpdateComponents : fixedUpdateComponents).remove(c);
 			}
 		}
 	}
@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include "Component.h"
-#include "Misc/vector.h"
+#include "Misc/Registry.h"
+#include "Core/JobSystem.h"
+#include "Misc/Profiler.h"
 #include <XPlatform/access.h>
 
 TRISTEON_UNIQUE_ACCESS_DECL()
@@ -18,6 +20,7 @@ namespace Tristeon
 			/**
 			 * ComponentManager keeps track of existing components and runs callbacks on them when needed.
 			 * ComponentManager implements a basic (de)register system that listens to the initailization of new components.
+			 * Components are only added to the lists of the callbacks that their type overrides, so empty default callbacks are never called.
 			 *
 			 * This class is not intended to be accessed or used by users.
 			 */
@@ -27,30 +30,65 @@ namespace Tristeon
 
 				ComponentManager();
 				/**
-				 * Calls function f on every registered component
+				 * Calls function f on every component in the given list
 				 */
 				template <void (Component::*func)()>
-				void callFunction();
+				void callFunction(const Registry<Component>& list);
+				/**
+				 * Calls function f on every component in the given list, split into chunks across the job system
+				 */
+				template <void (Component::*func)()>
+				void callFunctionParallel(const Registry<Component>& list);
 
 				/**
 				 * Adds the component that is attached to Message to the component list
 				 * \exception runtime_error If msg.userData is null or when msg.userData can not successfuly cast to Component
 				 */
-				void registerComponent(Message msg);
+				void registerComponent(const Message& msg);
 				/**
 				 * Removes the component that is attached to Message from the component list
 				 * \exception runtime_error If msg.userData is null or if msg.userData can not successfuly cast to Component
 				 */
-				void deregisterComponent(Message msg);
-				vector<Component*> components;
+				void deregisterComponent(const Message& msg);
+
+				/**
+				 * The registered components that override the respective callback
+				 */
+				Registry<Component> startComponents;
+				Registry<Component> updateComponents;
+				Registry<Component> lateUpdateComponents;
+				Registry<Component> fixedUpdateComponents;
+				/**
+				 * The registered components that declared the respective callback parallel safe
+				 */
+				Registry<Component> parallelUpdateComponents;
+				Registry<Component> parallelFixedUpdateComponents;
+
+				/**
+				 * The amount of components per job in parallel callbacks
+				 */
+				static const size_t parallelChunkSize = 256;
 			};
 
 			template <void(Component::*func)()>
-			void ComponentManager::callFunction()
+			void ComponentManager::callFunction(const Registry<Component>& list)
 			{
-				for (Component* c : components)
+				TRISTEON_PROFILE_SCOPE("ComponentManager::callFunction");
+				for (Component* c : list)
 					(c->*func)();
 			}
+
+			template <void(Component::*func)()>
+			void ComponentManager::callFunctionParallel(const Registry<Component>& list)
+			{
+				TRISTEON_PROFILE_SCOPE("ComponentManager::callFunctionParallel");
+				JobSystem::parallelFor(list.size(), parallelChunkSize, [&list](size_t begin, size_t end)
+				{
+					TRISTEON_PROFILE_SCOPE("ComponentManager::callFunctionParallel chunk");
+					for (size_t i = begin; i < end; i++)
+						(list[i]->*func)();
+				});
+			}
 		}
 	}
 }
@@ -0,0 +1,134 @@
+﻿#include "ComponentPool.h"
+#include "Editor/TypeRegister.h"
+#include "Misc/Console.h"
+
+#include <algorithm>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Components
+		{
+			ComponentPool::ComponentPool(uint32_t type, size_t size, size_t alignment) : type(type), alignment(alignment)
+			{
+				//Round the size up to the alignment so that every slot is aligned
+				stride = (size + alignment - 1) / alignment * alignment;
+				chunkCapacity = std::max<size_t>(16, chunkBytes / stride);
+			}
+
+			Component* ComponentPool::create(const std::string& typeID)
+			{
+				const TypeRegister::TypeInfo* info = TypeRegister::getTypeInfo(typeID);
+				if (info == nullptr)
+				{
+					Misc::Console::warning("Trying to create a component of unregistered type " + typeID);
+					return nullptr;
+				}
+
+				ComponentPool* pool = getPool(typeID, info->size, info->alignment);
+				uint32_t index;
+				Serializable* instance = info->constructAt(pool->allocate(index));
+
+				Component* component = dynamic_cast<Component*>(instance);
+				if (component == nullptr)
+				{
+					Misc::Console::warning("Trying to create a component of type " + typeID + ", which isn't a component!");
+					instance->~Serializable();
+					pool->release(index);
+					return nullptr;
+				}
+
+				pool->occupy(index, component);
+				return component;
+			}
+
+			ComponentPool* ComponentPool::getPool(const std::string& typeID, size_t size, size_t alignment)
+			{
+				auto& pools = getPools();
+				const auto it = pools.find(typeID);
+				if (it != pools.end())
+					return it->second.get();
+
+				ComponentPool* pool = new ComponentPool(ComponentTypes::id(typeID), size, alignment);
+				pools[typeID] = std::unique_ptr<ComponentPool>(pool);
+				return pool;
+			}
+
+			std::map<std::string, std::unique_ptr<ComponentPool>>& ComponentPool::getPools()
+			{
+				//Intentionally never destroyed, components that are owned by static objects may outlive any static pool map
+				static auto* pools = new std::map<std::string, std::unique_ptr<ComponentPool>>();
+				return *pools;
+			}
+
+			void* ComponentPool::allocate(uint32_t& index)
+			{
+				if (freeSlots.empty())
+				{
+					Chunk chunk;
+					chunk.memory.resize(stride * chunkCapacity + alignment);
+					const uintptr_t address = reinterpret_cast<uintptr_t>(chunk.memory.data());
+					chunk.begin = reinterpret_cast<unsigned char*>((address + alignment - 1) / alignment * alignment);
+					chunk.objects.resize(chunkCapacity, nullptr);
+
+					//Push in reverse so that slots are handed out in memory order
+					const uint32_t first = (uint32_t)(chunks.size() * chunkCapacity);
+					for (size_t i = chunkCapacity; i > 0; i--)
+						freeSlots.push_back(first + (uint32_t)i - 1);
+					chunks.push_back(std::move(chunk));
+				}
+
+				index = freeSlots.back();
+				freeSlots.pop_back();
+				return chunks[index / chunkCapacity].begin + index % chunkCapacity * stride;
+			}
+
+			void ComponentPool::occupy(uint32_t index, Component* component)
+			{
+				chunks[index / chunkCapacity].objects[index % chunkCapacity] = component;
+				component->pool = this;
+				component->poolIndex = index;
+				component->componentType = type;
+				count++;
+			}
+
+			void ComponentPool::release(uint32_t index)
+			{
+				Component*& object = chunks[index / chunkCapacity].objects[index % chunkCapacity];
+				if (object != nullptr)
+					count--;
+				object = nullptr;
+				freeSlots.push_back(index);
+			}
+
+			Component* ComponentPool::front() const
+			{
+				for (const Chunk& chunk : chunks)
+				{
+					for (Component* c : chunk.objects)
+					{
+						if (c != nullptr)
+							return c;
+					}
+				}
+				return nullptr;
+			}
+
+			void ComponentDeleter::operator()(Component* component) const
+			{
+				ComponentPool* pool = component->pool;
+				if (pool == nullptr)
+				{
+					delete component;
+					return;
+				}
+
+				//The slot can only be reused after the component has been fully destroyed
+				const uint32_t index = component->poolIndex;
+				component->~Component();
+				pool->release(index);
+			}
+		}
+	}
+}
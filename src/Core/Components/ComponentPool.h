@@ -0,0 +1,177 @@
+﻿#pragma once
+#include <vector>
+#include <map>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <new>
+#include "XPlatform/typename.h"
+#include "ComponentTypes.h"
+#include "Misc/MemoryTracker.h"
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Components
+		{
+			class Component;
+
+			/**
+			 * ComponentPool stores all components of one exact type in chunks of contiguous memory.
+			 * Chunks are never moved or freed while the pool is alive, so the address of a component stays stable for its entire lifetime.
+			 * Freed slots are reused by the next component that gets created.
+			 *
+			 * Pools are created on demand, one per component type, and are shared by every scene.
+			 * This class is not intended to be accessed or used by users, use Scene::forEach() to iterate over components instead.
+			 */
+			class ComponentPool final
+			{
+				friend struct ComponentDeleter;
+			public:
+				/**
+				 * Creates a new component of type T in the pool of T
+				 */
+				template <typename T> static T* create();
+				/**
+				 * Creates a new component of the registered type with the given typeID. Returns nullptr if the type isn't a registered component.
+				 */
+				static Component* create(const std::string& typeID);
+
+				/**
+				 * Calls f(T*) for every live component that is of type T or derives from T.
+				 * Components are visited pool by pool, in memory order.
+				 */
+				template <typename T, typename F> static void forEach(F f);
+
+				/**
+				 * Returns the amount of live components in this pool
+				 */
+				size_t size() const { return count; }
+
+				/**
+				 * Calls f(Component*) for every live component in this pool, in memory order
+				 */
+				template <typename F> void forEachComponent(F f) const;
+
+				ComponentPool(const ComponentPool&) = delete;
+				ComponentPool& operator=(const ComponentPool&) = delete;
+			private:
+				ComponentPool(uint32_t type, size_t size, size_t alignment);
+
+				/**
+				 * A contiguous block of memory with room for a fixed amount of components
+				 */
+				struct Chunk
+				{
+					Misc::TaggedVector<unsigned char, Misc::MEM_COMPONENTS> memory;
+					unsigned char* begin = nullptr;
+					/**
+					 * The live component in each slot, nullptr if the slot is free
+					 */
+					std::vector<Component*> objects;
+				};
+
+				/**
+				 * Returns the pool that stores components of the given type, creates it if it doesn't exist yet.
+				 */
+				static ComponentPool* getPool(const std::string& typeID, size_t size, size_t alignment);
+				static std::map<std::string, std::unique_ptr<ComponentPool>>& getPools();
+
+				/**
+				 * Returns the memory of a free slot and outputs its index. The slot isn't marked as used until occupy() is called.
+				 */
+				void* allocate(uint32_t& index);
+				/**
+				 * Marks the slot as used by the given component, which must have been constructed in the memory returned by allocate()
+				 */
+				void occupy(uint32_t index, Component* component);
+				/**
+				 * Marks the slot as free. The component in it must already be destroyed.
+				 * Also returns slots that were allocated but never occupied.
+				 */
+				void release(uint32_t index);
+				/**
+				 * Returns the first live component in this pool, nullptr if the pool is empty
+				 */
+				Component* front() const;
+
+				/**
+				 * The ComponentTypes ID of the components in this pool
+				 */
+				uint32_t type;
+				size_t stride;
+				size_t alignment;
+				size_t chunkCapacity;
+				size_t count = 0;
+				std::vector<Chunk> chunks;
+				std::vector<uint32_t> freeSlots;
+
+				/**
+				 * The target size of a single chunk in bytes
+				 */
+				static const size_t chunkBytes = 16384;
+			};
+
+			/**
+			 * Destroys components that were created in a ComponentPool and returns their slot.
+			 * Components that weren't created in a pool are deleted normally.
+			 */
+			struct ComponentDeleter
+			{
+				void operator()(Component* component) const;
+			};
+		}
+	}
+}
+
+#include "Component.h"
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Components
+		{
+			template <typename T>
+			T* ComponentPool::create()
+			{
+				ComponentPool* pool = getPool(TRISTEON_TYPENAME(T), sizeof(T), alignof(T));
+				uint32_t index;
+				T* component = new (pool->allocate(index)) T();
+				pool->occupy(index, component);
+				return component;
+			}
+
+			template <typename T, typename F>
+			void ComponentPool::forEach(F f)
+			{
+				for (auto& pair : getPools())
+				{
+					ComponentPool* pool = pair.second.get();
+					if (pool->count == 0)
+						continue;
+
+					//Every component in a pool has the same type, so testing one of them is enough
+					if (dynamic_cast<T*>(pool->front()) == nullptr)
+						continue;
+
+					pool->forEachComponent([&](Component* c) { f(static_cast<T*>(c)); });
+				}
+			}
+
+			template <typename F>
+			void ComponentPool::forEachComponent(F f) const
+			{
+				for (const Chunk& chunk : chunks)
+				{
+					for (Component* c : chunk.objects)
+					{
+						if (c != nullptr)
+							f(c);
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,113 @@
+﻿#include "ComponentTypes.h"
+#include "Component.h"
+#include "Misc/Console.h"
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Components
+		{
+			uint32_t ComponentTypes::id(const std::string& typeName)
+			{
+				return registerType(typeName, nullptr, CC_ALL, 0);
+			}
+
+			bool ComponentTypes::isA(uint32_t type, uint32_t base, Component* instance)
+			{
+				if (type == base)
+					return true;
+
+				auto& types = getTypes();
+				TypeData& data = types[type];
+				if (!data.evaluated.test(base))
+				{
+					//A type that is never referred to statically can't be derived from by any type we know of
+					bool(*isInstance)(Component*) = types[base].isInstance;
+					if (isInstance == nullptr)
+						return false;
+
+					data.ancestors.set(base, isInstance(instance));
+					data.evaluated.set(base);
+				}
+				return data.ancestors.test(base);
+			}
+
+			const ComponentTypes::Mask& ComponentTypes::resolveAncestors(uint32_t type, Component* instance)
+			{
+				auto& types = getTypes();
+				TypeData& data = types[type];
+				if (data.resolvedTypes != types.size())
+				{
+					for (uint32_t base = 0; base < types.size(); base++)
+					{
+						if (!data.evaluated.test(base))
+							isA(type, base, instance);
+					}
+					data.resolvedTypes = (uint32_t)types.size();
+				}
+				return data.ancestors;
+			}
+
+			const ComponentTypes::Mask& ComponentTypes::getResolved(uint32_t type)
+			{
+				return getTypes()[type].evaluated;
+			}
+
+			uint8_t ComponentTypes::getCallbacks(uint32_t type)
+			{
+				if (type == unknownType)
+					return CC_ALL;
+				return getTypes()[type].callbacks;
+			}
+
+			uint8_t ComponentTypes::getParallelCallbacks(uint32_t type)
+			{
+				if (type == unknownType)
+					return 0;
+				return getTypes()[type].parallelCallbacks;
+			}
+
+			uint32_t ComponentTypes::registerType(const std::string& typeName, bool(*isInstance)(Component*), uint8_t callbacks, uint8_t parallelCallbacks)
+			{
+				auto& ids = getIDs();
+				auto& types = getTypes();
+
+				const auto it = ids.find(typeName);
+				if (it != ids.end())
+				{
+					//The type may have been registered by name before. Its callbacks are kept as they are,
+					//components that have already been registered rely on them to deregister.
+					if (types[it->second].isInstance == nullptr)
+						types[it->second].isInstance = isInstance;
+					return it->second;
+				}
+
+				Misc::Console::t_assert(types.size() < maxTypes, "Exceeded the maximum amount of component types: " + std::to_string(maxTypes));
+
+				const uint32_t id = (uint32_t)types.size();
+				TypeData data;
+				data.ancestors.set(id);
+				data.evaluated.set(id);
+				data.isInstance = isInstance;
+				data.callbacks = callbacks;
+				data.parallelCallbacks = parallelCallbacks;
+				types.push_back(data);
+				ids[typeName] = id;
+				return id;
+			}
+
+			std::vector<ComponentTypes::TypeData>& ComponentTypes::getTypes()
+			{
+				static std::vector<TypeData> types;
+				return types;
+			}
+
+			std::map<std::string, uint32_t>& ComponentTypes::getIDs()
+			{
+				static std::map<std::string, uint32_t> ids;
+				return ids;
+			}
+		}
+	}
+}
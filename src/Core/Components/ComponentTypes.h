@@ -0,0 +1,152 @@
+﻿#pragma once
+#include <bitset>
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+#include "XPlatform/typename.h"
+#include "Editor/TypeRegister.h"
+#include <type_traits>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Components
+		{
+			class Component;
+
+			/**
+			 * Describes which of the engine callbacks of Component a component type overrides
+			 */
+			enum ComponentCallback : uint8_t
+			{
+				CC_START = 1 << 0,
+				CC_UPDATE = 1 << 1,
+				CC_LATEUPDATE = 1 << 2,
+				CC_FIXEDUPDATE = 1 << 3,
+
+				CC_ALL = CC_START | CC_UPDATE | CC_LATEUPDATE | CC_FIXEDUPDATE
+			};
+
+			/**
+			 * ComponentTypes assigns a small integer ID to every component type, which allows gameobjects to describe their components with a bitmask.
+			 * IDs are assigned once per type, the first time the type is used, after which ComponentTypes::id<T>() is a simple static read.
+			 *
+			 * Whether a component type derives from another type is resolved once per pair of types for the entire program,
+			 * and stored in the ancestor mask of the derived type. Every lookup afterwards is a bit test.
+			 *
+			 * This class is not thread safe. Lookups of pairs that have already been resolved only read, and can run in parallel.
+			 */
+			class ComponentTypes final
+			{
+			public:
+				/**
+				 * The maximum amount of distinct component types
+				 */
+				static const size_t maxTypes = 128;
+				using Mask = std::bitset<maxTypes>;
+				/**
+				 * The type of components that weren't created through a ComponentPool
+				 */
+				static const uint32_t unknownType = UINT32_MAX;
+
+				/**
+				 * Returns the ID of component type T
+				 */
+				template <typename T> static uint32_t id();
+				/**
+				 * Returns the ID of the component type with the given typename
+				 */
+				static uint32_t id(const std::string& typeName);
+
+				/**
+				 * Returns true if components of type [type] are of type [base] or derive from it.
+				 * The instance is used to resolve the relation the first time this pair of types is tested, and must be of type [type].
+				 */
+				static bool isA(uint32_t type, uint32_t base, Component* instance);
+				/**
+				 * Resolves whether components of [type] derive from each of the registered types, so that isA() only reads its cache for those.
+				 * Returns the types that [type] is or derives from. The instance must be of type [type].
+				 */
+				static const Mask& resolveAncestors(uint32_t type, Component* instance);
+				/**
+				 * Returns the types for which the relation to [type] has been resolved
+				 */
+				static const Mask& getResolved(uint32_t type);
+
+				/**
+				 * Returns a combination of ComponentCallback values, describing which callbacks the given type overrides.
+				 * Types that have only been referred to by name, and unknownType, are assumed to override all callbacks.
+				 */
+				static uint8_t getCallbacks(uint32_t type);
+				/**
+				 * Returns the callbacks of the given type that have been declared safe to run in parallel, see Component::parallelCallbacks.
+				 */
+				static uint8_t getParallelCallbacks(uint32_t type);
+
+			private:
+				struct TypeData
+				{
+					/**
+					 * The types this type is or derives from, only valid for the bits in evaluated
+					 */
+					Mask ancestors;
+					Mask evaluated;
+					/**
+					 * The amount of registered types when resolveAncestors() last resolved this type
+					 */
+					uint32_t resolvedTypes = 0;
+					/**
+					 * Tests whether a component is of this type. Nullptr if the type has only been referred to by name so far.
+					 */
+					bool(*isInstance)(Component*) = nullptr;
+					uint8_t callbacks = CC_ALL;
+					uint8_t parallelCallbacks = 0;
+				};
+
+				/**
+				 * Detects which callbacks T overrides. Taking the address of a function that T doesn't override results in a pointer to a member of Component.
+				 */
+				template <typename T> static uint8_t findCallbacks();
+
+				static uint32_t registerType(const std::string& typeName, bool(*isInstance)(Component*), uint8_t callbacks, uint8_t parallelCallbacks);
+				static std::vector<TypeData>& getTypes();
+				static std::map<std::string, uint32_t>& getIDs();
+			};
+
+			template <typename T>
+			uint32_t ComponentTypes::id()
+			{
+				static const uint32_t value = registerType(TRISTEON_TYPENAME(T), [](Component* c) { return dynamic_cast<T*>(c) != nullptr; },
+					findCallbacks<T>(), findCallbacks<T>() & T::parallelCallbacks & (CC_UPDATE | CC_FIXEDUPDATE));
+				return value;
+			}
+
+			template <typename T>
+			uint8_t ComponentTypes::findCallbacks()
+			{
+				using callback = void (Component::*)();
+				uint8_t result = 0;
+				if (!std::is_same<decltype(&T::start), callback>::value)
+					result |= CC_START;
+				if (!std::is_same<decltype(&T::update), callback>::value)
+					result |= CC_UPDATE;
+				if (!std::is_same<decltype(&T::lateUpdate), callback>::value)
+					result |= CC_LATEUPDATE;
+				if (!std::is_same<decltype(&T::fixedUpdate), callback>::value)
+					result |= CC_FIXEDUPDATE;
+				return result;
+			}
+		}
+	}
+}
+
+/**
+ * Assigns component types their ID when they get registered, so that their callbacks are known before they are created by name.
+ */
+template <typename T>
+struct TypeRegisterHook<T, typename std::enable_if<std::is_base_of<Tristeon::Core::Components::Component, T>::value>::type>
+{
+	static void onRegister() { Tristeon::Core::Components::ComponentTypes::id<T>(); }
+};
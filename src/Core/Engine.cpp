@@ -2,22 +2,46 @@
 #include "BindingData.h"
 #include "UserPrefs.h"
 #include "Misc/Console.h"
+#include "Misc/Profiler.h"
+#include "Misc/FrameAllocator.h"
+#include "Misc/AllocationCounter.h"
+#include "Misc/MemoryTracker.h"
+#include "Misc/Hardware/Keyboard.h"
 
 #include "Rendering/Vulkan/WindowVulkan.h"
 #include "Rendering/Vulkan/RenderManagerVulkan.h"
+#include "Rendering/Null/RenderManagerNull.h"
 #include "Managers/InputManager.h"
 #include "Components/ComponentManager.h"
 #include "Scenes/SceneManager.h"
 #include "MessageBus.h"
+#include "TransformStore.h"
 #include "Misc/Hardware/Time.h"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
 namespace Tristeon
 {
 	namespace Core
 	{
-		Engine::Engine()
+		Engine::Engine(int argc, char** argv)
 		{
-			UserPrefs::readPrefs();
+			UserPrefs::readPrefs(argc, argv);
+#ifdef TRISTEON_PROFILE
+			Misc::Profiler::setThreadName("Main");
+#endif
+			//Memory budgets are set in megabytes per heap, e.g. BUDGET_MESHBATCH=256
+			for (int i = 0; i < Misc::MEM_COUNT; i++)
+			{
+				std::string name = Misc::MemoryTracker::getName((Misc::MemoryTag)i);
+				std::transform(name.begin(), name.end(), name.begin(), [](char c) { return (char)std::toupper(c); });
+				std::string const budget = UserPrefs::getStringValue("BUDGET_" + name);
+				if (!budget.empty())
+					Misc::MemoryTracker::setBudget((Misc::MemoryTag)i, (int64_t)(std::stod(budget) * 1024 * 1024));
+			}
+			jobSys = std::unique_ptr<JobSystem>(new JobSystem());
 
 			const std::string api = UserPrefs::getStringValue("RENDERAPI");
 			if (api == "VULKAN")
@@ -32,68 +56,154 @@ namespace Tristeon
 
 				renderSys = std::make_unique<Rendering::Vulkan::RenderManager>();
 			}
+			else if (api == "NULL")
+			{
+				//Headless, there is no window and thus no input either
+				renderSys = std::make_unique<Rendering::Null::RenderManager>();
+			}
 			else
 				Misc::Console::error(api + " is not supported as a rendering API!");
 
-			inputSys = std::make_unique<Managers::InputManager>(window->window);
+			if (window != nullptr)
+				inputSys = std::make_unique<Managers::InputManager>(window->window);
 			componentSys = std::make_unique<Components::ComponentManager>();
 			sceneSys = std::make_unique<Scenes::SceneManager>();
 
-			MessageBus::subscribeToMessage(MT_GAME_LOGIC_START, [&](Message msg)
+			MessageBus::subscribeToMessage(MT_GAME_LOGIC_START, [&](const Message& msg)
 			{
 				MessageBus::sendMessage(MT_START);
 				inPlayMode = true;
 			});
-			MessageBus::subscribeToMessage(MT_GAME_LOGIC_STOP, [&](Message msg) { inPlayMode = false; });
+			MessageBus::subscribeToMessage(MT_GAME_LOGIC_STOP, [&](const Message& msg) { inPlayMode = false; });
+			//Transient frame memory is released once the frame after it has finished
+			MessageBus::subscribeToMessage(MT_AFTERFRAME, [](const Message& msg) { Misc::FrameAllocator::nextFrame(); });
 		}
 
 		void Engine::run() const
 		{
-			double lastTime = glfwGetTime();
+			int frameLimit = UserPrefs::getIntValue("FRAMES");
+			if (isHeadless() && frameLimit <= 0)
+				frameLimit = headlessFrames;
+
+			auto const start = std::chrono::steady_clock::now();
+			auto lastTime = start;
 			float fixedUpdateTime = 0;
 			int frames = 0;
 			float time = 0;
+			uint64_t frameAllocations = 0;
 
-			while (!glfwWindowShouldClose(window->window))
+			for (int frameCount = 0; frameLimit <= 0 || frameCount < frameLimit; frameCount++)
 			{
-				glfwPollEvents();
+				if (window != nullptr)
+				{
+					if (glfwWindowShouldClose(window->window))
+						break;
+					glfwPollEvents();
+				}
+
+#ifdef TRISTEON_PROFILE
+				//Dumps the last frames, so that a hitch can be inspected right after it happened
+				if (Misc::Keyboard::getKeyDown(Misc::F12))
+				{
+					std::string const path = "Trace" + std::to_string(frameCount) + ".json";
+					if (Misc::Profiler::dump(path))
+						Misc::Console::write("Wrote profiler trace to " + path);
+				}
+#endif
+				//Dumps the memory heaps, compare dumps of a long session to find leaks and growth
+				if (Misc::Keyboard::getKeyDown(Misc::F11))
+				{
+					std::string const path = "Memory" + std::to_string(frameCount) + ".json";
+					if (Misc::MemoryTracker::dump(path))
+						Misc::Console::write("Wrote memory dump to " + path);
+				}
 
 				//Keep track of elapsed time and frames and calculate FPS
-				Misc::Time::deltaTime = glfwGetTime() - lastTime;
-				lastTime = glfwGetTime();
+				auto const now = std::chrono::steady_clock::now();
+				float const elapsed = std::chrono::duration<float>(now - lastTime).count();
+				lastTime = now;
 				frames++;
-				time += Misc::Time::deltaTime;
+				time += elapsed;
 				if (time >= 1)
 				{
 					Misc::Time::fps = float(frames);
 					frames = 0;
 					time--;
+					Misc::MemoryTracker::sample();
 				}
 
-				if (inPlayMode)
-				{
-					//FixedUpdate runs a fixed amount of times per second, the loop makes sure to catch up if we happen to be behind
-					fixedUpdateTime += Misc::Time::deltaTime;
-					while (fixedUpdateTime > 1.0f / 50.0f) //TODO: Make fixed delta time variable
-					{
-						MessageBus::sendMessage(MT_FIXEDUPDATE);
-						fixedUpdateTime -= 1.0f / 50.0f;
-					}
-
-					MessageBus::sendMessage(MT_UPDATE);
-					MessageBus::sendMessage(MT_LATEUPDATE);
-				}
+				//Headless runs use a fixed time step, so that every run simulates exactly the same frames
+				Misc::Time::deltaTime = isHeadless() ? headlessDeltaTime : elapsed;
 
 				//Only attempt to render if the window is a valid size
-				if (window->width.get() != 0 && window->height.get() != 0)
-				{
-					MessageBus::sendMessage(MT_PRERENDER);
-					MessageBus::sendMessage(MT_RENDER);
-					MessageBus::sendMessage(MT_POSTRENDER);
+				uint64_t const allocations = Misc::AllocationCounter::getAllocations();
+				frame(fixedUpdateTime, isHeadless() || (window->width.get() != 0 && window->height.get() != 0));
+				frameAllocations = Misc::AllocationCounter::getAllocations() - allocations;
+			}
+
+			//A steady state frame shouldn't allocate, see Misc/FrameAllocator.h for per frame scratch memory
+			if (Misc::AllocationCounter::isEnabled())
+				Misc::Console::write("The last frame made " + std::to_string(frameAllocations) + " heap allocations");
+
+			//Memory dumps of (headless) runs can be requested with the MEMORYDUMP setting
+			std::string const memoryDump = UserPrefs::getStringValue("MEMORYDUMP");
+			if (!memoryDump.empty() && Misc::MemoryTracker::dump(memoryDump))
+				Misc::Console::write("Wrote memory dump to " + memoryDump);
 
-					MessageBus::sendMessage(MT_AFTERFRAME);
+#ifdef TRISTEON_PROFILE
+			//Traces of (headless) runs can be requested with the TRACE setting
+			std::string const trace = UserPrefs::getStringValue("TRACE");
+			if (!trace.empty() && Misc::Profiler::dump(trace))
+				Misc::Console::write("Wrote profiler trace to " + trace);
+#endif
+
+			if (isHeadless())
+			{
+				double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				Misc::Console::write("Ran " + std::to_string(frameLimit) + " headless frames in " + std::to_string(seconds) + "s, " +
+					std::to_string(seconds * 1000.0 / frameLimit) + "ms per frame");
+			}
+		}
+
+		void Engine::frame(float& fixedUpdateTime, bool render) const
+		{
+			TRISTEON_PROFILE_SCOPE("Frame");
+
+			if (inPlayMode)
+			{
+				//FixedUpdate runs a fixed amount of times per second, the loop makes sure to catch up if we happen to be behind
+				fixedUpdateTime += Misc::Time::deltaTime;
+				while (fixedUpdateTime > 1.0f / 50.0f) //TODO: Make fixed delta time variable
+				{
+					MessageBus::sendMessage(MT_FIXEDUPDATE);
+					fixedUpdateTime -= 1.0f / 50.0f;
 				}
+
+				MessageBus::sendMessage(MT_UPDATE);
+				MessageBus::sendMessage(MT_LATEUPDATE);
 			}
+
+			//Handle everything that has been posted from other threads this frame
+			MessageBus::dispatchPostedMessages();
+
+			//Continue loading the scene that is being loaded in the background, if any
+			Scenes::SceneManager::updateLoading();
+
+			if (render)
+			{
+				MessageBus::sendMessage(MT_PRERENDER);
+
+				//Recalculate all the world matrices that have changed this frame in one go
+				TransformStore::update();
+
+				MessageBus::sendMessage(MT_RENDER);
+				MessageBus::sendMessage(MT_POSTRENDER);
+
+				MessageBus::sendMessage(MT_AFTERFRAME);
+			}
+
+			//GameObjects that have been destroyed this frame are removed in one go
+			Scenes::SceneManager::flushDestroyed();
 		}
 	}
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <Core/Rendering/RenderManager.h>
 #include <Scenes/SceneManager.h>
 #include <Core/Components/ComponentManager.h>
+#include <Core/JobSystem.h>
 
 namespace Tristeon
 {
@@ -19,16 +20,44 @@ namespace Tristeon
 		class Engine final
 		{
 		public:
-			Engine();
 			/**
-			 * Starts the main engine loop. 
-			 * Warning: This function starts an (almost) infinite loop. As such it only returns once the Engine closes.
-			 * 
+			 * Creates the engine subsystems. The command line arguments are passed on to UserPrefs.
+			 * With RENDERAPI=NULL the engine runs headless: no window is created, and nothing is sent to the GPU.
+			 *
 			 * \exception runtime_error Unsupported rendering API requested
 			 */
+			Engine(int argc = 0, char** argv = nullptr);
+			/**
+			 * Starts the main engine loop. 
+			 * Warning: This function starts an (almost) infinite loop. As such it only returns once the window closes, or once the FRAMES setting has been reached.
+			 * Headless engines always run for a fixed amount of frames, with a fixed time step.
+			 */
 			void run() const;
 
+			/**
+			 * Returns true if the engine runs without a window (RENDERAPI=NULL)
+			 */
+			bool isHeadless() const { return window == nullptr; }
+
 		private:
+			/**
+			 * Runs a single frame, using the current Time::deltaTime
+			 * \param fixedUpdateTime The time that hasn't been simulated by MT_FIXEDUPDATE yet, carried over between frames
+			 * \param render False if the window is minimized, skips rendering
+			 */
+			void frame(float& fixedUpdateTime, bool render) const;
+
+			/**
+			 * The time step of a headless frame in seconds
+			 */
+			static constexpr float headlessDeltaTime = 1.0f / 60.0f;
+			/**
+			 * The amount of frames that a headless engine runs for if FRAMES hasn't been set
+			 */
+			static const int headlessFrames = 1000;
+
+
+			std::unique_ptr<JobSystem> jobSys;
 			std::unique_ptr<Rendering::RenderManager> renderSys;
 			std::unique_ptr<Scenes::SceneManager> sceneSys;
 			std::unique_ptr<Rendering::Window> window;
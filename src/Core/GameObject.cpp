@@ -42,7 +42,13 @@ namespace Tristeon
 
 		void GameObject::deserialize(nlohmann::json json)
 		{
-			GET_STRING(instanceID, "instanceID");
+			deserialize(std::move(json), true);
+		}
+
+		void GameObject::deserialize(nlohmann::json json, bool initComponents)
+		{
+			const std::string instanceIDValue = json["instanceID"];
+			instanceID = parseInstanceID(instanceIDValue);
 			active = json["active"];
 			GET_STRING(name, "name");
 			GET_STRING(tag, "tag");
@@ -50,24 +56,108 @@ namespace Tristeon
 			{
 				GET_STRING(prefabFilePath, "prefabFilePath");
 			}
-			_transform->deserialize(json["transform"]);
-			components.clear();
-			for (auto serializedComponent : json["components"])
+			_transform->deserialize(std::move(json["transform"]));
+
+			//Existing components are updated in place instead of being recreated, so that they can hold on to their resources.
+			//The n-th serialized component of a type is matched to the n-th existing component of that type.
+			std::vector<std::unique_ptr<Components::Component, Components::ComponentDeleter>> previous = std::move(components);
+			clearComponents();
+			for (nlohmann::json& serializedComponent : json["components"])
 			{
-				//TODO: instead of recreating identify already existing components instead of removing those and load those
-				//in to avoid weird behavior and increase performance
+				const std::string typeID = serializedComponent["typeID"];
+				Components::Component* existing = nullptr;
+				if (TypeRegister::getTypeInfo(typeID) != nullptr)
+				{
+					uint32_t const type = Components::ComponentTypes::id(typeID);
+					for (auto& component : previous)
+					{
+						if (component && component->componentType == type)
+						{
+							existing = component.release();
+							break;
+						}
+					}
+				}
+
+				if (existing != nullptr)
+				{
+					existing->deserialize(std::move(serializedComponent));
+					registerComponent(existing);
+					continue;
+				}
 
 				//Create an instance using the given typeid, this creates an instance of the type
 				//which was serialized using its unique ID thus to retrieve the type.
-				auto serializable = TypeRegister::createInstance(serializedComponent["typeID"]);
-				Components::Component* component = (Components::Component*) serializable.get();
+				//The instance is constructed in the component pool of its type.
+				loadComponent(typeID, std::move(serializedComponent), initComponents);
+			}
+			//Components that weren't matched are destroyed along with previous
+		}
+
+		void GameObject::loadComponent(const std::string& typeID, nlohmann::json data, bool initialize)
+		{
+			Components::Component* component = Components::ComponentPool::create(typeID);
+			if (component == nullptr)
+				return;
+			if (initialize)
 				component->init();
-				component->setup(this);
-				serializable.release();
-				std::unique_ptr<Components::Component> sharedComponent(component);
-				sharedComponent->deserialize(serializedComponent);
-				components.push_back(std::move(sharedComponent));
+			component->setup(this);
+			component->deserialize(std::move(data));
+			registerComponent(component);
+		}
+
+		void GameObject::registerComponent(Components::Component* component)
+		{
+			uint32_t const type = component->componentType;
+			if (!componentMask.test(type))
+			{
+				componentMask.set(type);
+				componentTable.insert(componentTable.begin() + getTableIndex(type), (uint32_t)components.size());
+			}
+			components.emplace_back(component);
+
+			//The relations to all registered types are resolved here, on the main thread, so that looking components up by a base type
+			//only reads the caches, also from parallel updates. Only the positive results of the other components stay valid,
+			//the new component might derive from types that weren't found before.
+			derivedMask |= Components::ComponentTypes::resolveAncestors(type, component);
+			Components::ComponentTypes::Mask const& resolved = Components::ComponentTypes::getResolved(type);
+			derivedEvaluated = (components.size() == 1 ? resolved : derivedEvaluated & resolved) | derivedMask;
+		}
+
+		void GameObject::clearComponents()
+		{
+			components.clear();
+			componentMask.reset();
+			componentTable.clear();
+			derivedMask.reset();
+			derivedEvaluated.reset();
+		}
+
+		void GameObject::recycle()
+		{
+			for (size_t i = 0; i < components.size(); i++)
+				components[i]->deinit();
+			instanceID = generateInstanceID();
+			_transform->instanceID = generateInstanceID();
+			destroyed = false;
+			pooled = true;
+		}
+
+		bool GameObject::hasDerivedComponent(uint32_t type)
+		{
+			if (!derivedEvaluated.test(type))
+			{
+				for (size_t i = 0; i < components.size(); i++)
+				{
+					if (Components::ComponentTypes::isA(components[i]->componentType, type, components[i].get()))
+					{
+						derivedMask.set(type);
+						break;
+					}
+				}
+				derivedEvaluated.set(type);
 			}
+			return derivedMask.test(type);
 		}
 	}
 }
\ No newline at end of file
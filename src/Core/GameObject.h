@@ -1,8 +1,10 @@
 ﻿#pragma once
 #include "Transform.h"
 #include "Components/Component.h"
+#include "Components/ComponentPool.h"
 #include "Editor/TypeRegister.h"
 #include "Misc/Console.h"
+#include "Misc/MemoryTracker.h"
 #include <memory>
 
 namespace Tristeon
@@ -10,7 +12,7 @@ namespace Tristeon
 #ifdef TRISTEON_EDITOR
 	namespace Editor { class EditorNodeTree; class EditorNode; }
 #endif
-	namespace Scenes { class SceneManager; class Scene; }
+	namespace Scenes { class SceneManager; class Scene; class BinaryScene; }
 
 	namespace Core
 	{
@@ -21,10 +23,11 @@ namespace Tristeon
 		 * GameObject is the only type of entity that is directly allowed as an instance in the scene.
 		 * Its behavior is defined by the attached components (e.g. it might be visible by adding a renderer, might move around through a movement behavior etc)
 		 */
-		class GameObject : public TObject
+		class GameObject : public TObject, public Misc::Tracked<Misc::MEM_SCENE>
 		{
 			friend Scenes::Scene;
 			friend Scenes::SceneManager;
+			friend Scenes::BinaryScene;
 #ifdef TRISTEON_EDITOR
 			friend Editor::EditorNode;
 			friend Editor::EditorNodeTree;
@@ -47,6 +50,7 @@ namespace Tristeon
 
 			/**
 			 * Gets the first component of the given type T. Null if no matching component can be found.
+			 * Exact type matches are found in constant time, components that derive from T are found through a cached mask.
 			 */
 			template <typename T> T* getComponent();
 
@@ -63,11 +67,76 @@ namespace Tristeon
 			 * This function gets called after the scene has been fully loaded. The game does not have to be running.
 			 */
 			void init();
+			/**
+			 * Deserializes the GameObject. If initComponents is false, the components aren't initialized until init() is called.
+			 */
+			void deserialize(nlohmann::json json, bool initComponents);
 
 			std::unique_ptr<Transform> _transform;
-			std::vector<std::unique_ptr<Components::Component>> components;
+			/**
+			 * The components attached to this gameobject. Components live in their type's ComponentPool, the deleter returns them to it.
+			 */
+			std::vector<std::unique_ptr<Components::Component, Components::ComponentDeleter>> components;
+
+			/**
+			 * Adds an already setup component to the component list and updates the type lookup.
+			 */
+			void registerComponent(Components::Component* component);
+			/**
+			 * Creates a component of the given type in its pool, deserializes it from the given data and adds it to the component list.
+			 */
+			void loadComponent(const std::string& typeID, nlohmann::json data, bool initialize = true);
+			/**
+			 * Removes all components and resets the type lookup.
+			 */
+			void clearComponents();
+			/**
+			 * Prepares a destroyed GameObject for reuse. Its components are kept but deregistered from engine callbacks,
+			 * and it and its transform get new instanceIDs.
+			 */
+			void recycle();
+			/**
+			 * Returns the ComponentTypes ID of the exact type of the component at the given index in the component list
+			 */
+			uint32_t getComponentType(size_t index) const { return components[index]->componentType; }
+			/**
+			 * Returns true if any of the components derives from the given type.
+			 * Resolved for every registered type when a component is added, types that are registered later are resolved and cached on first use.
+			 */
+			bool hasDerivedComponent(uint32_t type);
+
+			/**
+			 * The exact types of the attached components
+			 */
+			Components::ComponentTypes::Mask componentMask;
+			/**
+			 * For every bit set in componentMask, in order, the index of the first component of that type.
+			 */
+			std::vector<uint32_t> componentTable;
+			/**
+			 * The types that any of the components derive from, only valid for the bits in derivedEvaluated
+			 */
+			Components::ComponentTypes::Mask derivedMask;
+			Components::ComponentTypes::Mask derivedEvaluated;
+
+			/**
+			 * Returns the index in componentTable of the given type, which is the amount of present types with a lower ID.
+			 */
+			size_t getTableIndex(uint32_t type) const { return (componentMask & (~Components::ComponentTypes::Mask() >> (Components::ComponentTypes::maxTypes - type))).count(); }
 
 			bool active = true;
+			/**
+			 * True once the GameObject has been marked for destruction by Scene::destroy()
+			 */
+			bool destroyed = false;
+			/**
+			 * True while the GameObject is kept by a PrefabTemplate for reuse. Its components are skipped by Scene::forEach()
+			 */
+			bool pooled = false;
+			/**
+			 * The slot of the GameObject in the scene that contains it, see Scene::resolve()
+			 */
+			uint32_t sceneSlot = UINT32_MAX;
 
 			/**
 			 * The filepath of the prefab this GameObject might be attached to. "" if it's not a prefab.
@@ -81,25 +150,28 @@ namespace Tristeon
 		template <typename T>
         typename std::enable_if<std::is_base_of<Components::Component, T>::value, T>::type* GameObject::addComponent()
 		{
-			T* component = new T();
+			T* component = Components::ComponentPool::create<T>();
 			component->setup(this);
-			components.push_back(std::move(std::unique_ptr<T>(component)));
+			registerComponent(component);
 			return component;
 		}
 
 		template <typename T>
 		T* GameObject::getComponent()
 		{
-			if (!std::is_base_of<Components::Component, T>())
-			{
-				Misc::Console::error("Type T is not of type Component in getComponent<T>!");
+			static_assert(std::is_base_of<Components::Component, T>::value, "Type T is not of type Component in getComponent<T>!");
+
+			uint32_t const type = Components::ComponentTypes::id<T>();
+			if (componentMask.test(type))
+				return static_cast<T*>(components[componentTable[getTableIndex(type)]].get());
+
+			if (!hasDerivedComponent(type))
 				return nullptr;
-			}
 
-			for (int i = 0; i < components.size(); i++)
+			for (size_t i = 0; i < components.size(); i++)
 			{
-				if (dynamic_cast<T>(components[i].get()) != nullptr)
-					return components[i].get();
+				if (Components::ComponentTypes::isA(components[i]->componentType, type, components[i].get()))
+					return static_cast<T*>(components[i].get());
 			}
 			return nullptr;
 		}
@@ -117,17 +189,17 @@ namespace Tristeon
 		template <typename T>
 		std::vector<T*> GameObject::getComponents()
 		{
-			if (!std::is_base_of<Components::Component, T>())
-			{
-				Misc::Console::error("Type T is not of type Component in getComponents<T>!");
-				return nullptr;
-			}
+			static_assert(std::is_base_of<Components::Component, T>::value, "Type T is not of type Component in getComponents<T>!");
+
+			std::vector<T*> result;
+			uint32_t const type = Components::ComponentTypes::id<T>();
+			if (!componentMask.test(type) && !hasDerivedComponent(type))
+				return result;
 
-			std::vector<Components::Component*> result;
-			for (int i = 0; i < components.size(); i++)
+			for (size_t i = 0; i < components.size(); i++)
 			{
-				if (dynamic_cast<T>(components[i].get()) != nullptr)
-					result.push_back(components[i].get());
+				if (Components::ComponentTypes::isA(components[i]->componentType, type, components[i].get()))
+					result.push_back(static_cast<T*>(components[i].get()));
 			}
 			return result;
 		}
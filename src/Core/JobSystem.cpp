@@ -0,0 +1,234 @@
+﻿#include "JobSystem.h"
+#include "Misc/Profiler.h"
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		JobSystem* JobSystem::instance = nullptr;
+		thread_local size_t JobSystem::queueIndex = 0;
+
+		JobSystem::JobSystem(size_t workerCount)
+		{
+			if (workerCount == 0)
+			{
+				unsigned int const hardware = std::thread::hardware_concurrency();
+				workerCount = hardware > 1 ? hardware - 1 : 0;
+			}
+
+			//The main thread, the workers and the background thread
+			for (size_t i = 0; i <= workerCount + 1; i++)
+				queues.push_back(std::make_unique<Queue>());
+
+			instance = this;
+			for (size_t i = 1; i <= workerCount; i++)
+				workers.emplace_back(&JobSystem::workerLoop, this, i);
+			background = std::thread(&JobSystem::backgroundLoop, this);
+		}
+
+		JobSystem::~JobSystem()
+		{
+			{
+				std::lock_guard<std::mutex> lock(sleepMutex);
+				std::lock_guard<std::mutex> backgroundLock(backgroundMutex);
+				running = false;
+			}
+			wake.notify_all();
+			backgroundWake.notify_all();
+
+			//The background thread finishes its remaining jobs before it returns. The workers stop right away,
+			//a background job that waits for jobs it has scheduled runs them itself in JobSystem::wait()
+			background.join();
+			for (std::thread& worker : workers)
+				worker.join();
+
+			//The workers stop without emptying their queues, whatever is left (including jobs released by it) runs here
+			while (tryRunJob(queueIndex)) { }
+
+			if (instance == this)
+				instance = nullptr;
+		}
+
+		void JobSystem::schedule(std::function<void()> task, JobCounter* signal, JobCounter* dependency)
+		{
+			if (signal != nullptr)
+				++signal->value;
+
+			if (instance == nullptr)
+			{
+				//No worker threads, execute right away. Dependencies have already finished for the same reason.
+				task();
+				if (signal != nullptr)
+					--signal->value;
+				return;
+			}
+
+			Job job { std::move(task), signal };
+			if (dependency != nullptr)
+			{
+				std::lock_guard<std::mutex> lock(dependency->mutex);
+				if (dependency->value.load() != 0)
+				{
+					dependency->waiting.push_back(std::move(job));
+					return;
+				}
+			}
+			instance->push(queueIndex, std::move(job));
+		}
+
+		void JobSystem::scheduleBackground(std::function<void()> task, JobCounter* signal)
+		{
+			if (instance == nullptr)
+			{
+				schedule(std::move(task), signal);
+				return;
+			}
+
+			if (signal != nullptr)
+				++signal->value;
+			{
+				std::lock_guard<std::mutex> lock(instance->backgroundMutex);
+				instance->backgroundJobs.push_back({ std::move(task), signal });
+			}
+			instance->backgroundWake.notify_one();
+		}
+
+		void JobSystem::wait(JobCounter& counter)
+		{
+			while (counter.value.load() != 0)
+			{
+				if (instance == nullptr || !instance->tryRunJob(queueIndex, &counter))
+					std::this_thread::yield();
+			}
+
+			//The last job might still be releasing its dependents, the counter can't be destroyed before it's done
+			std::lock_guard<std::mutex> lock(counter.mutex);
+		}
+
+		size_t JobSystem::getWorkerCount()
+		{
+			return instance != nullptr ? instance->workers.size() : 0;
+		}
+
+		void JobSystem::push(size_t queue, Job job)
+		{
+			{
+				std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+				queues[queue]->jobs.push_back(std::move(job));
+			}
+
+			//Lock the sleep mutex so a worker can't miss the notification in between checking for work and going to sleep
+			{
+				std::lock_guard<std::mutex> lock(sleepMutex);
+				++queued;
+			}
+			wake.notify_one();
+		}
+
+		bool JobSystem::tryRunJob(size_t queue, const JobCounter* only)
+		{
+			Job job;
+			bool found = false;
+
+			//Own queue first, newest job first for cache locality
+			{
+				Queue& own = *queues[queue];
+				std::lock_guard<std::mutex> lock(own.mutex);
+				for (auto it = own.jobs.rbegin(); it != own.jobs.rend(); ++it)
+				{
+					if (only != nullptr && it->signal != only)
+						continue;
+					job = std::move(*it);
+					own.jobs.erase(std::next(it).base());
+					found = true;
+					break;
+				}
+			}
+
+			//Steal the oldest job from another queue
+			for (size_t i = 1; !found && i < queues.size(); i++)
+			{
+				Queue& other = *queues[(queue + i) % queues.size()];
+				std::lock_guard<std::mutex> lock(other.mutex);
+				for (auto it = other.jobs.begin(); it != other.jobs.end(); ++it)
+				{
+					if (only != nullptr && it->signal != only)
+						continue;
+					job = std::move(*it);
+					other.jobs.erase(it);
+					found = true;
+					break;
+				}
+			}
+
+			if (!found)
+				return false;
+
+			--queued;
+			{
+				TRISTEON_PROFILE_SCOPE("JobSystem::job");
+				job.task();
+			}
+			finish(job.signal);
+			return true;
+		}
+
+		void JobSystem::workerLoop(size_t queue)
+		{
+			queueIndex = queue;
+#ifdef TRISTEON_PROFILE
+			Misc::Profiler::setThreadName("Worker " + std::to_string(queue));
+#endif
+			while (running)
+			{
+				if (tryRunJob(queue))
+					continue;
+
+				std::unique_lock<std::mutex> lock(sleepMutex);
+				wake.wait(lock, [&]() { return !running || queued.load() > 0; });
+			}
+		}
+
+		void JobSystem::backgroundLoop()
+		{
+			queueIndex = queues.size() - 1;
+#ifdef TRISTEON_PROFILE
+			Misc::Profiler::setThreadName("Background");
+#endif
+			while (true)
+			{
+				Job job;
+				{
+					std::unique_lock<std::mutex> lock(backgroundMutex);
+					backgroundWake.wait(lock, [&]() { return !running || !backgroundJobs.empty(); });
+					if (backgroundJobs.empty())
+						return;
+					job = std::move(backgroundJobs.front());
+					backgroundJobs.pop_front();
+				}
+
+				{
+					TRISTEON_PROFILE_SCOPE("JobSystem::backgroundJob");
+					job.task();
+				}
+				finish(job.signal);
+			}
+		}
+
+		void JobSystem::finish(JobCounter* signal)
+		{
+			if (signal == nullptr)
+				return;
+
+			std::vector<Job> released;
+			{
+				std::lock_guard<std::mutex> lock(signal->mutex);
+				if (--signal->value == 0)
+					released.swap(signal->waiting);
+			}
+
+			for (Job& job : released)
+				push(queueIndex, std::move(job));
+		}
+	}
+}
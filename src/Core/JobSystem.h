@@ -0,0 +1,186 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		class Engine;
+		class JobSystem;
+		class JobCounter;
+
+		/**
+		 * A job is a function that can be executed on any thread.
+		 */
+		struct Job
+		{
+			std::function<void()> task;
+			/**
+			 * The counter that gets decremented once the job has finished. Can be null.
+			 */
+			JobCounter* signal = nullptr;
+		};
+
+		/**
+		 * JobCounter keeps track of the amount of unfinished jobs that have been scheduled with it.
+		 * Jobs can be made dependent on a counter, they'll be released once the counter reaches zero.
+		 * A counter must outlive every job that signals it, JobSystem::wait() guarantees this.
+		 */
+		class JobCounter
+		{
+			friend JobSystem;
+		public:
+			JobCounter() = default;
+			JobCounter(const JobCounter&) = delete;
+			JobCounter& operator=(const JobCounter&) = delete;
+
+			/**
+			 * Returns true if all the jobs that signal this counter have finished
+			 */
+			bool isDone() const { return value.load() == 0; }
+		private:
+			std::atomic<int> value { 0 };
+			/**
+			 * Protects waiting, and the transition of value to zero
+			 */
+			std::mutex mutex;
+			/**
+			 * Jobs that depend on this counter, they get scheduled once value reaches zero
+			 */
+			std::vector<Job> waiting;
+		};
+
+		/**
+		 * JobSystem runs jobs on a pool of worker threads. Every worker (and the main thread) owns a queue of jobs.
+		 * Threads take jobs from the back of their own queue, and steal from the front of other queues when they run out of work.
+		 * The main thread doesn't idle while waiting for jobs, it executes the jobs of the counter it waits on until that counter reaches zero.
+		 * Long running jobs, like reading files, are scheduled with scheduleBackground() and run on a separate background thread.
+		 *
+		 * The job system is created by the engine. If no job system exists, jobs are executed immediately on the calling thread.
+		 */
+		class JobSystem final
+		{
+			friend Engine;
+		public:
+			/**
+			 * Schedules a job.
+			 * \param task The function to execute
+			 * \param signal Optional counter that gets incremented now, and decremented once the job has finished
+			 * \param dependency Optional counter, the job won't start until it has reached zero
+			 */
+			static void schedule(std::function<void()> task, JobCounter* signal = nullptr, JobCounter* dependency = nullptr);
+			/**
+			 * Schedules a long running job on the background thread. Background jobs run one at a time, in the order they were scheduled.
+			 * They are never picked up by wait(), so they can't stall the thread that waits. Jobs that haven't started when the job system is destroyed are dropped.
+			 * \param task The function to execute
+			 * \param signal Optional counter that gets incremented now, and decremented once the job has finished
+			 */
+			static void scheduleBackground(std::function<void()> task, JobCounter* signal = nullptr);
+
+			/**
+			 * Blocks until the given counter reaches zero. While waiting, the calling thread executes the jobs that signal the counter.
+			 */
+			static void wait(JobCounter& counter);
+
+			/**
+			 * Splits [0, count) into chunks of chunkSize, and calls f(begin, end) for each chunk across all threads.
+			 * The first chunk runs on the calling thread. Returns once all chunks have been executed.
+			 */
+			template <typename F>
+			static void parallelFor(size_t count, size_t chunkSize, F f);
+
+			/**
+			 * Returns the amount of worker threads, excluding the main thread. 0 if the job system doesn't exist.
+			 */
+			static size_t getWorkerCount();
+
+			/**
+			 * Stops the threads once the background thread has finished its remaining jobs.
+			 * Jobs that are still queued are executed on the calling thread, so that every JobCounter reaches zero.
+			 */
+			~JobSystem();
+		private:
+			/**
+			 * Starts the given amount of worker threads. Uses one worker per hardware thread, minus the main thread, if workerCount is 0.
+			 */
+			explicit JobSystem(size_t workerCount = 0);
+
+			struct Queue
+			{
+				/**
+				 * A vector rather than a deque, it keeps its capacity so that scheduling doesn't allocate once the queue has grown
+				 */
+				std::vector<Job> jobs;
+				std::mutex mutex;
+			};
+
+			void push(size_t queue, Job job);
+			/**
+			 * Takes a job from the given queue, or steals one from another queue, and executes it. Returns false if there's no work.
+			 * If only is set, only jobs that signal that counter are taken.
+			 */
+			bool tryRunJob(size_t queue, const JobCounter* only = nullptr);
+			void workerLoop(size_t queue);
+			void backgroundLoop();
+			/**
+			 * Decrements the job's counter and releases the jobs that depend on it
+			 */
+			void finish(JobCounter* signal);
+
+			/**
+			 * One queue per thread, the main thread (and any non worker thread) uses queue 0 and the background thread uses the last queue.
+			 * The background thread's queue only holds the jobs that background jobs schedule themselves.
+			 */
+			std::vector<std::unique_ptr<Queue>> queues;
+			std::vector<std::thread> workers;
+
+			/**
+			 * The jobs that are waiting for the background thread
+			 */
+			std::deque<Job> backgroundJobs;
+			std::mutex backgroundMutex;
+			std::condition_variable backgroundWake;
+			std::thread background;
+
+			std::atomic<bool> running { true };
+			/**
+			 * The amount of jobs in all queues, used to put idle workers to sleep
+			 */
+			std::atomic<size_t> queued { 0 };
+			std::mutex sleepMutex;
+			std::condition_variable wake;
+
+			static JobSystem* instance;
+			static thread_local size_t queueIndex;
+		};
+
+		template <typename F>
+		void JobSystem::parallelFor(size_t count, size_t chunkSize, F f)
+		{
+			chunkSize = std::max<size_t>(chunkSize, 1);
+			if (instance == nullptr || count <= chunkSize)
+			{
+				f((size_t)0, count);
+				return;
+			}
+
+			//The jobs only capture two words, small enough for std::function to store them without allocating
+			struct Range { F* f; size_t count; size_t chunkSize; } const range { &f, count, chunkSize };
+			const Range* r = &range;
+			JobCounter counter;
+			for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+				schedule([r, begin]() { (*r->f)(begin, std::min(r->count, begin + r->chunkSize)); }, &counter);
+
+			f((size_t)0, chunkSize);
+			wait(counter);
+		}
+	}
+}
@@ -14,7 +14,7 @@ namespace Tristeon
 		{
 			InputManager::InputManager(GLFWwindow* window)
 			{
-				MessageBus::subscribeToMessage(MT_AFTERFRAME, [&](Message msg) { resetInput(); });
+				MessageBus::subscribeToMessage(MT_AFTERFRAME, [&](const Message& msg) { resetInput(); });
 				Misc::Mouse::window = window;
 				glfwSetKeyCallback(window, [](GLFWwindow* window, int key, int scancode, int action, int mods) { Misc::Keyboard::keyCallback(key, scancode, action, mods); });
 				glfwSetMouseButtonCallback(window, [](GLFWwindow* window, int button, int action, int mods) { Misc::Mouse::buttonCallback(button, action, mods); });
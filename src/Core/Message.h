@@ -38,6 +38,11 @@ namespace Tristeon
 			MT_WINDOW_RESIZE,
 
 			MT_SHARE_DATA,
+
+			/**
+			 * The amount of message types, not a valid message type
+			 */
+			MT_COUNT
 		};
 
 		/**
@@ -1,29 +1,190 @@
 ﻿#include "MessageBus.h"
-#include "UserPrefs.h"
 #include "Message.h"
+#include "Misc/Profiler.h"
+
+#include <algorithm>
 
 namespace Tristeon
 {
 	namespace Core
 	{
-		std::map<MessageType, Misc::Delegate<Message>> MessageBus::messageCallbacks;
+		std::array<std::vector<MessageBus::MessageCallback>, MT_COUNT> MessageBus::messageCallbacks;
+		std::array<std::vector<MessageBus::BatchCallback>, MT_COUNT> MessageBus::batchCallbacks;
+		std::vector<std::shared_ptr<void>> MessageBus::functionObjects;
+		std::atomic<MessageBus::PostedMessage*> MessageBus::posted { nullptr };
+		std::atomic<MessageBus::PostedMessage*> MessageBus::freeNodes { nullptr };
+		unsigned int MessageBus::batchDepth = 0;
+		std::array<std::vector<Message>, MT_COUNT> MessageBus::batched;
+
+#ifdef TRISTEON_PROFILE
+		/**
+		 * The profiler names of the message types, so that every message type shows up as its own scope
+		 */
+		static const char* const messageTypeNames[] =
+		{
+			"MT_START", "MT_UPDATE", "MT_LATEUPDATE", "MT_FIXEDUPDATE", "MT_PRERENDER", "MT_RENDER", "MT_POSTRENDER", "MT_AFTERFRAME", "MT_QUIT",
+			"MT_MANAGER_RESET",
+			"MT_RENDERINGCOMPONENT_REGISTER", "MT_SCRIPTINGCOMPONENT_REGISTER",
+			"MT_CAMERA_REGISTER", "MT_CAMERA_DEREGISTER",
+			"MT_RENDERINGCOMPONENT_DEREGISTER", "MT_SCRIPTINGCOMPONENT_DEREGISTER",
+			"MT_GAME_LOGIC_START", "MT_GAME_LOGIC_STOP",
+			"MT_WINDOW_RESIZE",
+			"MT_SHARE_DATA"
+		};
+		static_assert(sizeof(messageTypeNames) / sizeof(messageTypeNames[0]) == MT_COUNT, "Every message type needs a profiler name");
+#endif
+
+		void MessageBus::sendMessage(const Message& message)
+		{
+			dispatch(&message, 1);
+		}
+
+		void MessageBus::postMessage(const Message& message)
+		{
+			thread_local NodeCache cache;
+			if (cache.nodes == nullptr)
+				cache.nodes = freeNodes.exchange(nullptr, std::memory_order_acquire);
+
+			//Nodes are only allocated until enough of them circulate between the posting threads and dispatchPostedMessages
+			PostedMessage* node = cache.nodes;
+			if (node != nullptr)
+			{
+				cache.nodes = node->next;
+				node->message = message;
+			}
+			else
+				node = new PostedMessage { message, nullptr };
+
+			node->next = posted.load(std::memory_order_relaxed);
+			while (!posted.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) { }
+		}
+
+		void MessageBus::sendBatchable(const Message& message)
+		{
+			if (batchDepth > 0)
+				batched[message.type].push_back(message);
+			else
+				dispatch(&message, 1);
+		}
+
+		bool MessageBus::cancelBatched(const Message& message)
+		{
+			if (batchDepth == 0)
+				return false;
+			auto& messages = batched[message.type];
+			auto const it = std::find_if(messages.begin(), messages.end(), [&](const Message& m) { return m.userData == message.userData; });
+			if (it == messages.end())
+				return false;
+			messages.erase(it);
+			return true;
+		}
+
+		MessageBus::Batch::Batch()
+		{
+			batchDepth++;
+		}
 
-		void MessageBus::sendMessage(Message message)
+		MessageBus::Batch::~Batch()
 		{
-			validateMessageType(message.type);
-			messageCallbacks[message.type].invoke(message);
+			if (--batchDepth == 0)
+				dispatchBatched();
 		}
 
-		void MessageBus::subscribeToMessage(MessageType type, std::function<void(Message)> f)
+		void MessageBus::dispatchBatched()
 		{
-			validateMessageType(type);
-			messageCallbacks[type] += f;
+			//Messages sent by the callbacks are batched as well, the buffer being dispatched is swapped out so that they can't invalidate it
+			static std::vector<Message> messages;
+			batchDepth++;
+			bool dispatched = true;
+			while (dispatched)
+			{
+				dispatched = false;
+				for (auto& pending : batched)
+				{
+					if (pending.empty())
+						continue;
+					messages.swap(pending);
+					dispatch(messages.data(), messages.size());
+					messages.clear();
+					dispatched = true;
+				}
+			}
+			batchDepth--;
 		}
 
-		void MessageBus::validateMessageType(MessageType type)
+		void MessageBus::subscribeToMessage(MessageType type, void (*f)(void* context, const Message& message), void* context)
 		{
-			if (!messageCallbacks.count(type))
-				messageCallbacks[type] = Misc::Delegate<Message>();
+			messageCallbacks[type].push_back({ f, context });
+		}
+
+		void MessageBus::subscribeToBatch(MessageType type, void (*f)(void* context, const Message* messages, size_t count), void* context)
+		{
+			batchCallbacks[type].push_back({ f, context });
+		}
+
+		void MessageBus::dispatchPostedMessages()
+		{
+			PostedMessage* node = posted.exchange(nullptr, std::memory_order_acquire);
+			if (node == nullptr)
+				return;
+
+			//The list is in reverse posting order
+			static std::vector<Message> messages;
+			messages.clear();
+			PostedMessage* const first = node;
+			PostedMessage* last = node;
+			for (; node != nullptr; node = node->next)
+			{
+				messages.push_back(node->message);
+				last = node;
+			}
+			releaseNodes(first, last);
+			std::reverse(messages.begin(), messages.end());
+
+			//Coalesce runs of the same type into one batch
+			size_t begin = 0;
+			while (begin < messages.size())
+			{
+				size_t end = begin + 1;
+				while (end < messages.size() && messages[end].type == messages[begin].type)
+					end++;
+				dispatch(&messages[begin], end - begin);
+				begin = end;
+			}
+		}
+
+		void MessageBus::releaseNodes(PostedMessage* first, PostedMessage* last)
+		{
+			last->next = freeNodes.load(std::memory_order_relaxed);
+			while (!freeNodes.compare_exchange_weak(last->next, first, std::memory_order_release, std::memory_order_relaxed)) { }
+		}
+
+		MessageBus::NodeCache::~NodeCache()
+		{
+			if (nodes == nullptr)
+				return;
+			PostedMessage* last = nodes;
+			while (last->next != nullptr)
+				last = last->next;
+			releaseNodes(nodes, last);
+		}
+
+		void MessageBus::dispatch(const Message* messages, size_t count)
+		{
+			MessageType const type = messages[0].type;
+			TRISTEON_PROFILE_SCOPE(messageTypeNames[type]);
+
+			//Indexed on purpose, callbacks are allowed to subscribe new callbacks
+			auto& callbacks = messageCallbacks[type];
+			for (size_t i = 0; i < count; i++)
+			{
+				for (size_t j = 0; j < callbacks.size(); j++)
+					callbacks[j].function(callbacks[j].context, messages[i]);
+			}
+
+			auto& batches = batchCallbacks[type];
+			for (size_t j = 0; j < batches.size(); j++)
+				batches[j].function(batches[j].context, messages, count);
 		}
 	}
 }
\ No newline at end of file
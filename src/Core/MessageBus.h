@@ -1,37 +1,182 @@
 ﻿#pragma once
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
 #include "Message.h"
-#include "Misc/Delegate.h"
 
 namespace Tristeon
 {
 	namespace Core
 	{
+		class Engine;
+
 		/**
 		 * The MessageBus is an abstract message bus that allows for subsystems to communicate information back/forth
 		 * without knowledge of the existence one another.
+		 *
+		 * Subscribers are stored in one contiguous list per message type, in a fixed array indexed by the message type.
+		 * Each subscriber is a plain function pointer and a context pointer, so calling one is a single indirect call.
+		 * Sending a message doesn't allocate or perform any lookups.
+		 *
+		 * sendMessage() and subscribing are main thread only. Other threads use postMessage(),
+		 * posted messages are dispatched on the main thread once per frame, before MT_PRERENDER.
 		 */
 		class MessageBus final
 		{
+			friend Engine;
 		public:
 			/**
 			 * Sends a message to all listeners subscribed to message.type
 			 */
-			static void sendMessage(Message message);
+			static void sendMessage(const Message& message);
+
+			/**
+			 * Queues a message to be sent on the main thread before the next MT_PRERENDER. Can be called from any thread.
+			 * Message.userData must stay valid until the message has been dispatched.
+			 */
+			static void postMessage(const Message& message);
+
+			/**
+			 * Sends the message, or adds it to the open Batch. Used by registration messages,
+			 * so that registering many components at once reaches subscribeToBatch() callbacks in a single call per type.
+			 */
+			static void sendBatchable(const Message& message);
+
+			/**
+			 * Removes the message from the open batch. Deregistrations cancel their registration first,
+			 * so that it can't be dispatched after the deregistration or after its userData has been destroyed.
+			 * \return True if the message was still batched, it has never been sent
+			 */
+			static bool cancelBatched(const Message& message);
+
+			/**
+			 * Keeps a batch open for as long as it exists. Main thread only.
+			 * Messages sent with sendBatchable() are collected per type while a batch is open, when the outermost batch closes
+			 * they're dispatched one type at a time, in the order of the MessageType enum.
+			 */
+			class Batch final
+			{
+			public:
+				Batch();
+				~Batch();
+				Batch(const Batch&) = delete;
+				Batch& operator=(const Batch&) = delete;
+			};
 
 			/**
 			 * Adds a function to the message callbacks based on the given message type
 			 * \param type The type of message the given function should listen to
+			 * \param context Passed to every call of f, must stay valid for as long as the subscription exists
+			 */
+			static void subscribeToMessage(MessageType type, void (*f)(void* context, const Message& message), void* context);
+			/**
+			 * Adds a function object to the message callbacks based on the given message type. The MessageBus keeps a copy of f.
+			 * \param type The type of message the given function should listen to
+			 */
+			template<typename F>
+			static void subscribeToMessage(MessageType type, F f);
+
+			/**
+			 * Adds a function that receives messages of the given type in batches.
+			 * Consecutive posted messages of the same type are passed in a single call, as are the messages of the same type in a Batch.
+			 * Sent messages are passed as a batch of one.
+			 * \param type The type of message the given function should listen to
+			 * \param context Passed to every call of f, must stay valid for as long as the subscription exists
+			 */
+			static void subscribeToBatch(MessageType type, void (*f)(void* context, const Message* messages, std::size_t count), void* context);
+			/**
+			 * Adds a function object that receives messages of the given type in batches. The MessageBus keeps a copy of f.
+			 * \param type The type of message the given function should listen to
 			 */
-			static void subscribeToMessage(MessageType type, std::function<void(Message)> f);
+			template<typename F>
+			static void subscribeToBatch(MessageType type, F f);
 
 		private:
 			/**
-			 * Validates if the given messagetype has already been added to the callback system. If not, the type will be added.
+			 * Sends all posted messages in the order they were posted
+			 */
+			static void dispatchPostedMessages();
+			/**
+			 * Calls the regular callbacks for each message, and the batch callbacks once for all of them. All messages must be of the same type.
+			 */
+			static void dispatch(const Message* messages, std::size_t count);
+
+			struct MessageCallback
+			{
+				void (*function)(void* context, const Message& message);
+				void* context;
+			};
+			struct BatchCallback
+			{
+				void (*function)(void* context, const Message* messages, std::size_t count);
+				void* context;
+			};
+			static std::array<std::vector<MessageCallback>, MT_COUNT> messageCallbacks;
+			static std::array<std::vector<BatchCallback>, MT_COUNT> batchCallbacks;
+			/**
+			 * The function objects that were subscribed, they're the contexts of their callbacks
 			 */
-			static void validateMessageType(MessageType type);
+			static std::vector<std::shared_ptr<void>> functionObjects;
 
-			static std::map<MessageType, Misc::Delegate<Message>> messageCallbacks;
+			/**
+			 * A node in the intrusive list of posted messages
+			 */
+			struct PostedMessage
+			{
+				Message message;
+				PostedMessage* next;
+			};
+			/**
+			 * The most recently posted message. Producers push onto this lock-free list, the main thread takes the whole list at once.
+			 */
+			static std::atomic<PostedMessage*> posted;
+			/**
+			 * The amount of open batches
+			 */
+			static unsigned int batchDepth;
+			/**
+			 * The messages sent with sendBatchable() while a batch is open, per type
+			 */
+			static std::array<std::vector<Message>, MT_COUNT> batched;
+			/**
+			 * Dispatches the batched messages, including the ones sent by the callbacks in the meantime
+			 */
+			static void dispatchBatched();
+			/**
+			 * Nodes of dispatched messages, ready to be reused. The main thread returns every dispatched list at once,
+			 * producers take the whole free list at once into their NodeCache. Neither side pops single nodes, so the list is safe from ABA.
+			 */
+			static std::atomic<PostedMessage*> freeNodes;
+			/**
+			 * The free nodes owned by one posting thread, returned to freeNodes when the thread exits
+			 */
+			struct NodeCache
+			{
+				PostedMessage* nodes = nullptr;
+				~NodeCache();
+			};
+			/**
+			 * Pushes the list of nodes from first to last onto freeNodes
+			 */
+			static void releaseNodes(PostedMessage* first, PostedMessage* last);
 		};
+
+		template <typename F>
+		void MessageBus::subscribeToMessage(MessageType type, F f)
+		{
+			std::shared_ptr<F> const object = std::make_shared<F>(std::move(f));
+			functionObjects.push_back(object);
+			subscribeToMessage(type, [](void* context, const Message& message) { (*static_cast<F*>(context))(message); }, object.get());
+		}
+
+		template <typename F>
+		void MessageBus::subscribeToBatch(MessageType type, F f)
+		{
+			std::shared_ptr<F> const object = std::make_shared<F>(std::move(f));
+			functionObjects.push_back(object);
+			subscribeToBatch(type, [](void* context, const Message* messages, std::size_t count) { (*static_cast<F*>(context))(messages, count); }, object.get());
+		}
 	}
 }
\ No newline at end of file
@@ -19,8 +19,11 @@ namespace Tristeon
 			void MeshRenderer::initInternalRenderer()
 			{
 				//Select based on rendering api
-				if (UserPrefs::getStringValue("RENDERAPI") == "VULKAN")
+				const std::string api = UserPrefs::getStringValue("RENDERAPI");
+				if (api == "VULKAN")
 					renderer = new Vulkan::InternalMeshRenderer(this);
+				else if (api == "NULL")
+					renderer = nullptr; //The null backend doesn't draw, so there's nothing to create
 				else
 					Misc::Console::error("Trying to create a MeshRenderer with unsupported rendering API");
 			}
@@ -40,22 +43,26 @@ namespace Tristeon
 			{
 				const std::string meshFilePathValue = json["meshPath"];
 				const unsigned int submeshIDValue = json["subMeshID"];
+				const std::string materialPathValue = json["materialPath"];
+				load(meshFilePathValue, submeshIDValue, materialPathValue);
+			}
 
-				if (meshFilePath != meshFilePathValue || subMeshID != submeshIDValue)
+			void MeshRenderer::load(const std::string& meshPath, uint32_t subMeshID, const std::string& materialPath)
+			{
+				if (meshFilePath != meshPath || this->subMeshID != subMeshID)
 				{
-					if (filesystem::exists(meshFilePathValue))
-						mesh = Data::MeshBatch::getSubMesh(meshFilePathValue, submeshIDValue);
+					if (filesystem::exists(meshPath))
+						mesh = Data::MeshBatch::getSubMesh(meshPath, subMeshID);
 					else
 						mesh = Data::SubMesh();
 				}
 
-				meshFilePath = meshFilePathValue;
-				subMeshID = submeshIDValue;
+				meshFilePath = meshPath;
+				this->subMeshID = subMeshID;
 
-				const std::string materialPathValue = json["materialPath"];
-				if (materialPath != materialPathValue)
-					material = RenderManager::getMaterial(materialPathValue);
-				materialPath = materialPathValue;
+				if (this->materialPath != materialPath)
+					material = RenderManager::getMaterial(materialPath);
+				this->materialPath = materialPath;
 			}
 		}
 	}
@@ -23,6 +23,7 @@ namespace Tristeon
 				SetProperty(mesh)
 				{
 					_mesh = value;
+					setBoundsDirty();
 					if (renderer != nullptr)
 						renderer->onMeshChange(value);
 				}
@@ -33,6 +34,19 @@ namespace Tristeon
 				*/
 				void initInternalRenderer() override;
 
+				/**
+				 * \brief Returns the bounds of the mesh
+				 */
+				Math::AABB getBounds() const override { return _mesh.bounds; }
+
+				/**
+				 * \brief Loads the given submesh and material, the ones that are already loaded are kept
+				 * \param meshPath The filepath of the mesh
+				 * \param subMeshID The index of the submesh within the mesh file
+				 * \param materialPath The filepath of the material
+				 */
+				void load(const std::string& meshPath, uint32_t subMeshID, const std::string& materialPath);
+
 				nlohmann::json serialize() override;
 				void deserialize(nlohmann::json json) override;
 			private:
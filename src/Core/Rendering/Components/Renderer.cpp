@@ -18,7 +18,7 @@ namespace Tristeon
 			Renderer::~Renderer()
 			{
 				//Deregister ourselves
-				if (registered)
+				if (registered && !MessageBus::cancelBatched({ MT_RENDERINGCOMPONENT_REGISTER, dynamic_cast<TObject*>(this) }))
 					MessageBus::sendMessage({ MT_RENDERINGCOMPONENT_DEREGISTER, dynamic_cast<TObject*>(this) });
 
 				//Cleanup renderer
@@ -29,9 +29,16 @@ namespace Tristeon
 			void Renderer::init()
 			{
 				if (!registered)
-					MessageBus::sendMessage({MT_RENDERINGCOMPONENT_REGISTER, dynamic_cast<TObject*>(this) });
+					MessageBus::sendBatchable({ MT_RENDERINGCOMPONENT_REGISTER, dynamic_cast<TObject*>(this) });
 				registered = true;
 			}
+
+			void Renderer::deinit()
+			{
+				if (registered && !MessageBus::cancelBatched({ MT_RENDERINGCOMPONENT_REGISTER, dynamic_cast<TObject*>(this) }))
+					MessageBus::sendMessage({ MT_RENDERINGCOMPONENT_DEREGISTER, dynamic_cast<TObject*>(this) });
+				Component::deinit();
+			}
 		}
 	}
 }
@@ -2,6 +2,7 @@
 #include "Core/Rendering/Internal/InternalRenderer.h"
 #include "Core/Components/Component.h"
 #include "Core/Rendering/Material.h"
+#include "Math/AABB.h"
 
 namespace Tristeon
 {
@@ -39,6 +40,10 @@ namespace Tristeon
 				 * \brief Registers the renderer to the rendering system 
 				 */
 				void init() override;
+				/**
+				 * \brief Deregisters the renderer from the rendering system, the internal renderer is kept for when it registers again
+				 */
+				void deinit() override;
 				/**
 				 * \brief Creates and initializes the internal renderer
 				 */
@@ -56,7 +61,18 @@ namespace Tristeon
 				 * \return Returns the internal renderer
 				 */
 				InternalRenderer* getInternalRenderer() const { return renderer; }
+
+				/**
+				 * \brief Returns the local space bounds of what the renderer draws, used for culling.
+				 * Renderers with empty bounds have nothing to draw and are never visible.
+				 */
+				virtual Math::AABB getBounds() const { return Math::AABB(); }
 			protected:
+				/**
+				 * \brief Notifies the render manager that the result of getBounds() has changed
+				 */
+				void setBoundsDirty() { boundsDirty = true; }
+
 				/**
 				 * \brief The Filepath of the material
 				 */
@@ -71,6 +87,20 @@ namespace Tristeon
 				Material* _material = nullptr;
 
 				bool registered = false;
+			private:
+				/**
+				 * \brief The proxy of the renderer in the render manager's bounding volume hierarchy, -1 if it isn't in it
+				 */
+				int32_t cullingProxy = -1;
+				/**
+				 * \brief The transform version that the culling bounds were last calculated with
+				 */
+				uint32_t boundsVersion = 0;
+				bool boundsDirty = true;
+				/**
+				 * \brief The index of the renderer in the render manager's renderer registry
+				 */
+				uint32_t registryIndex = UINT32_MAX;
 			};
 		}
 	}
@@ -0,0 +1,361 @@
+﻿#include "DynamicBVH.h"
+#include <algorithm>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Rendering
+		{
+			int32_t DynamicBVH::insert(const Math::AABB& bounds, Renderer* renderer)
+			{
+				int32_t const leaf = allocateNode();
+				nodes[leaf].bounds = fatten(bounds);
+				nodes[leaf].height = 0;
+				nodes[leaf].renderer = renderer;
+				insertLeaf(leaf);
+				leafCount++;
+				return leaf;
+			}
+
+			void DynamicBVH::remove(int32_t proxy)
+			{
+				removeLeaf(proxy);
+				freeNode(proxy);
+				leafCount--;
+			}
+
+			bool DynamicBVH::update(int32_t proxy, const Math::AABB& bounds)
+			{
+				//Small movements stay within the fat box
+				if (nodes[proxy].bounds.contains(bounds))
+					return false;
+
+				removeLeaf(proxy);
+				nodes[proxy].bounds = fatten(bounds);
+				insertLeaf(proxy);
+				return true;
+			}
+
+			void DynamicBVH::clear()
+			{
+				nodes.clear();
+				root = nullNode;
+				freeList = nullNode;
+				leafCount = 0;
+			}
+
+			size_t DynamicBVH::query(const Math::Frustum& frustum, std::vector<Renderer*>& visible) const
+			{
+				if (root == nullNode)
+					return 0;
+
+				//Nodes that are completely inside of the frustum push their children inverted (~index), those don't need to be tested anymore
+				size_t tested = 0;
+				stack.clear();
+				candidates.clear();
+				stack.push_back(root);
+				while (!stack.empty())
+				{
+					int32_t const value = stack.back();
+					stack.pop_back();
+
+					if (value < 0)
+					{
+						const Node& node = nodes[~value];
+						if (node.isLeaf())
+							visible.push_back(node.renderer);
+						else
+						{
+							stack.push_back(~node.left);
+							stack.push_back(~node.right);
+						}
+						continue;
+					}
+
+					//Leaves are collected and tested together afterwards
+					const Node& node = nodes[value];
+					if (node.isLeaf())
+					{
+						candidates.push_back(value);
+						continue;
+					}
+
+					tested++;
+					Math::FrustumTest const result = frustum.test(node.bounds);
+					if (result == Math::FT_OUTSIDE)
+						continue;
+
+					if (result == Math::FT_INSIDE)
+					{
+						stack.push_back(~node.left);
+						stack.push_back(~node.right);
+					}
+					else
+					{
+						stack.push_back(node.left);
+						stack.push_back(node.right);
+					}
+				}
+
+				if (candidates.empty())
+					return tested;
+
+				candidateBounds.clear();
+				candidateBounds.reserve(candidates.size());
+				for (int32_t const leaf : candidates)
+					candidateBounds.add(nodes[leaf].bounds);
+				candidateResults.resize(candidates.size());
+				frustum.intersects(candidateBounds, candidateResults.data());
+
+				for (size_t i = 0; i < candidates.size(); i++)
+				{
+					if (candidateResults[i])
+						visible.push_back(nodes[candidates[i]].renderer);
+				}
+				return tested + candidates.size();
+			}
+
+			int32_t DynamicBVH::allocateNode()
+			{
+				if (freeList == nullNode)
+				{
+					nodes.emplace_back();
+					return (int32_t)nodes.size() - 1;
+				}
+
+				int32_t const node = freeList;
+				freeList = nodes[node].parent;
+				nodes[node] = Node();
+				return node;
+			}
+
+			void DynamicBVH::freeNode(int32_t node)
+			{
+				nodes[node] = Node();
+				nodes[node].parent = freeList;
+				freeList = node;
+			}
+
+			void DynamicBVH::insertLeaf(int32_t leaf)
+			{
+				if (root == nullNode)
+				{
+					root = leaf;
+					nodes[root].parent = nullNode;
+					return;
+				}
+
+				//Walk down the tree, picking the child that results in the lowest increase in surface area
+				Math::AABB const leafBounds = nodes[leaf].bounds;
+				int32_t index = root;
+				while (!nodes[index].isLeaf())
+				{
+					const Node& node = nodes[index];
+					float const area = node.bounds.getPerimeter();
+					float const combinedArea = Math::AABB::merge(node.bounds, leafBounds).getPerimeter();
+
+					//Cost of creating a new parent for this node and the new leaf
+					float const cost = 2 * combinedArea;
+					//Minimum cost of pushing the leaf further down the tree
+					float const inheritanceCost = 2 * (combinedArea - area);
+
+					auto descendCost = [&](int32_t child)
+					{
+						const Node& c = nodes[child];
+						float const merged = Math::AABB::merge(c.bounds, leafBounds).getPerimeter();
+						return c.isLeaf() ? merged + inheritanceCost : merged - c.bounds.getPerimeter() + inheritanceCost;
+					};
+					float const leftCost = descendCost(node.left);
+					float const rightCost = descendCost(node.right);
+
+					if (cost < leftCost && cost < rightCost)
+						break;
+					index = leftCost < rightCost ? node.left : node.right;
+				}
+
+				//Create a new parent for the sibling and the leaf
+				int32_t const sibling = index;
+				int32_t const oldParent = nodes[sibling].parent;
+				int32_t const newParent = allocateNode();
+				nodes[newParent].parent = oldParent;
+				nodes[newParent].bounds = Math::AABB::merge(leafBounds, nodes[sibling].bounds);
+				nodes[newParent].height = nodes[sibling].height + 1;
+				nodes[newParent].left = sibling;
+				nodes[newParent].right = leaf;
+				nodes[sibling].parent = newParent;
+				nodes[leaf].parent = newParent;
+
+				if (oldParent != nullNode)
+				{
+					if (nodes[oldParent].left == sibling)
+						nodes[oldParent].left = newParent;
+					else
+						nodes[oldParent].right = newParent;
+				}
+				else
+					root = newParent;
+
+				refit(oldParent);
+			}
+
+			void DynamicBVH::removeLeaf(int32_t leaf)
+			{
+				if (leaf == root)
+				{
+					root = nullNode;
+					return;
+				}
+
+				//The sibling takes the place of the parent
+				int32_t const parent = nodes[leaf].parent;
+				int32_t const grandParent = nodes[parent].parent;
+				int32_t const sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+				if (grandParent != nullNode)
+				{
+					if (nodes[grandParent].left == parent)
+						nodes[grandParent].left = sibling;
+					else
+						nodes[grandParent].right = sibling;
+					nodes[sibling].parent = grandParent;
+					freeNode(parent);
+					refit(grandParent);
+				}
+				else
+				{
+					root = sibling;
+					nodes[sibling].parent = nullNode;
+					freeNode(parent);
+				}
+				nodes[leaf].parent = nullNode;
+			}
+
+			void DynamicBVH::refit(int32_t node)
+			{
+				while (node != nullNode)
+				{
+					node = balance(node);
+
+					Node& n = nodes[node];
+					n.height = 1 + std::max(nodes[n.left].height, nodes[n.right].height);
+					n.bounds = Math::AABB::merge(nodes[n.left].bounds, nodes[n.right].bounds);
+					node = n.parent;
+				}
+			}
+
+			int32_t DynamicBVH::balance(int32_t iA)
+			{
+				Node& a = nodes[iA];
+				if (a.isLeaf() || a.height < 2)
+					return iA;
+
+				int32_t const iB = a.left;
+				int32_t const iC = a.right;
+				Node& b = nodes[iB];
+				Node& c = nodes[iC];
+				int32_t const difference = c.height - b.height;
+
+				//Rotate C up
+				if (difference > 1)
+				{
+					int32_t const iF = c.left;
+					int32_t const iG = c.right;
+					Node& f = nodes[iF];
+					Node& g = nodes[iG];
+
+					//C takes the place of A
+					c.left = iA;
+					c.parent = a.parent;
+					a.parent = iC;
+					if (c.parent != nullNode)
+					{
+						if (nodes[c.parent].left == iA)
+							nodes[c.parent].left = iC;
+						else
+							nodes[c.parent].right = iC;
+					}
+					else
+						root = iC;
+
+					//The higher grandchild stays with C, the other one moves to A
+					if (f.height > g.height)
+					{
+						c.right = iF;
+						a.right = iG;
+						g.parent = iA;
+						a.bounds = Math::AABB::merge(b.bounds, g.bounds);
+						c.bounds = Math::AABB::merge(a.bounds, f.bounds);
+						a.height = 1 + std::max(b.height, g.height);
+						c.height = 1 + std::max(a.height, f.height);
+					}
+					else
+					{
+						c.right = iG;
+						a.right = iF;
+						f.parent = iA;
+						a.bounds = Math::AABB::merge(b.bounds, f.bounds);
+						c.bounds = Math::AABB::merge(a.bounds, g.bounds);
+						a.height = 1 + std::max(b.height, f.height);
+						c.height = 1 + std::max(a.height, g.height);
+					}
+					return iC;
+				}
+
+				//Rotate B up
+				if (difference < -1)
+				{
+					int32_t const iD = b.left;
+					int32_t const iE = b.right;
+					Node& d = nodes[iD];
+					Node& e = nodes[iE];
+
+					//B takes the place of A
+					b.left = iA;
+					b.parent = a.parent;
+					a.parent = iB;
+					if (b.parent != nullNode)
+					{
+						if (nodes[b.parent].left == iA)
+							nodes[b.parent].left = iB;
+						else
+							nodes[b.parent].right = iB;
+					}
+					else
+						root = iB;
+
+					//The higher grandchild stays with B, the other one moves to A
+					if (d.height > e.height)
+					{
+						b.right = iD;
+						a.left = iE;
+						e.parent = iA;
+						a.bounds = Math::AABB::merge(c.bounds, e.bounds);
+						b.bounds = Math::AABB::merge(a.bounds, d.bounds);
+						a.height = 1 + std::max(c.height, e.height);
+						b.height = 1 + std::max(a.height, d.height);
+					}
+					else
+					{
+						b.right = iE;
+						a.left = iD;
+						d.parent = iA;
+						a.bounds = Math::AABB::merge(c.bounds, d.bounds);
+						b.bounds = Math::AABB::merge(a.bounds, e.bounds);
+						a.height = 1 + std::max(c.height, d.height);
+						b.height = 1 + std::max(a.height, e.height);
+					}
+					return iB;
+				}
+
+				return iA;
+			}
+
+			Math::AABB DynamicBVH::fatten(const Math::AABB& bounds)
+			{
+				glm::vec3 const margin = bounds.getExtents() * 0.1f + glm::vec3(0.05f);
+				return Math::AABB(bounds.min - margin, bounds.max + margin);
+			}
+		}
+	}
+}
@@ -0,0 +1,120 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+#include "Math/AABB.h"
+#include "Math/Frustum.h"
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Rendering
+		{
+			//Forward decl
+			class Renderer;
+
+			/**
+			 * \brief DynamicBVH is a bounding volume hierarchy over renderers, that is updated incrementally as renderers move.
+			 * Leaves store a slightly enlarged (fat) box, so that small movements don't require the tree to be changed.
+			 * Leaves that move outside of their fat box are reinserted, which refits the boxes of their ancestors.
+			 * The tree is kept balanced through rotations, similar to an AVL tree.
+			 */
+			class DynamicBVH
+			{
+			public:
+				/**
+				 * \brief Inserts a renderer with the given world space bounds
+				 * \return The proxy of the renderer, used to update or remove it
+				 */
+				int32_t insert(const Math::AABB& bounds, Renderer* renderer);
+				/**
+				 * \brief Removes the proxy from the tree
+				 */
+				void remove(int32_t proxy);
+				/**
+				 * \brief Updates the world space bounds of the proxy
+				 * \return True if the tree had to be changed
+				 */
+				bool update(int32_t proxy, const Math::AABB& bounds);
+				/**
+				 * \brief Removes all proxies
+				 */
+				void clear();
+
+				/**
+				 * \brief Appends every renderer whose box intersects the frustum to visible
+				 * \param frustum The frustum to test against
+				 * \param visible The output list, isn't cleared
+				 * \return The amount of boxes that have been tested against the frustum
+				 */
+				size_t query(const Math::Frustum& frustum, std::vector<Renderer*>& visible) const;
+
+				/**
+				 * \brief The amount of renderers in the tree
+				 */
+				size_t size() const { return leafCount; }
+				/**
+				 * \brief The height of the tree, 0 if it's empty
+				 */
+				int32_t getHeight() const { return root == nullNode ? 0 : nodes[root].height + 1; }
+
+				static const int32_t nullNode = -1;
+			private:
+				struct Node
+				{
+					/**
+					 * \brief The fat box for leaves, the union of the children for branches
+					 */
+					Math::AABB bounds;
+					/**
+					 * \brief The parent of the node, or the next free node while the node is unused
+					 */
+					int32_t parent = nullNode;
+					int32_t left = nullNode;
+					int32_t right = nullNode;
+					/**
+					 * \brief 0 for leaves, -1 for unused nodes
+					 */
+					int32_t height = -1;
+					Renderer* renderer = nullptr;
+
+					bool isLeaf() const { return left == nullNode; }
+				};
+
+				int32_t allocateNode();
+				void freeNode(int32_t node);
+				void insertLeaf(int32_t leaf);
+				void removeLeaf(int32_t leaf);
+				/**
+				 * \brief Recalculates the bounds and heights of the ancestors of the given node, rebalancing them on the way up
+				 */
+				void refit(int32_t node);
+				/**
+				 * \brief Rotates the subtree at the given node if it's imbalanced, returns the new root of the subtree
+				 */
+				int32_t balance(int32_t node);
+
+				/**
+				 * \brief Returns the given bounds enlarged by the fat margin
+				 */
+				static Math::AABB fatten(const Math::AABB& bounds);
+
+				std::vector<Node> nodes;
+				int32_t root = nullNode;
+				int32_t freeList = nullNode;
+				size_t leafCount = 0;
+
+				/**
+				 * \brief Reused by query() to avoid allocating every frame
+				 */
+				mutable std::vector<int32_t> stack;
+				/**
+				 * \brief The leaves that still need to be tested by query(), they're tested in bulk at the end
+				 */
+				mutable std::vector<int32_t> candidates;
+				mutable Math::AABBArray candidateBounds;
+				mutable std::vector<uint8_t> candidateResults;
+			};
+		}
+	}
+}
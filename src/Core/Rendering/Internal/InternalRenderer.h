@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "Core/TObject.h"
 #include "Data/Mesh.h"
+#include "Misc/MemoryTracker.h"
 
 namespace Tristeon {
 	namespace Data {
@@ -25,7 +26,7 @@ namespace Tristeon
 			 * API specific draw calls without interfering with the automatic component system.
 			 * It is generally used by the Renderer class / its subclasses.
 			 */
-			class InternalRenderer : public TObject
+			class InternalRenderer : public TObject, public Misc::Tracked<Misc::MEM_RENDERING>
 			{
 			public:
 				InternalRenderer(Renderer* renderer);
@@ -6,6 +6,7 @@
 #include "Editor/TypeRegister.h"
 #include "ShaderFile.h"
 #include "Math/Vector3.h"
+#include "Misc/MemoryTracker.h"
 
 #ifdef TRISTEON_EDITOR
 namespace Tristeon {
@@ -26,14 +27,16 @@ namespace Tristeon
 		{
 			//Forward decl
 			namespace Vulkan { class RenderManager; }
+			namespace Null { class RenderManager; }
 			class RenderManager;
 
 			/**
 			 * \brief The material controls the appearance of renderers in the world
 			 */
-			class Material : public TObject
+			class Material : public TObject, public Misc::Tracked<Misc::MEM_RENDERING>
 			{
 				friend Vulkan::RenderManager;
+				friend Null::RenderManager;
 				friend RenderManager;
 #ifdef TRISTEON_EDITOR
 				friend Editor::MaterialFileItem;
@@ -0,0 +1,20 @@
+﻿#include "DebugDrawManagerNull.h"
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Rendering
+		{
+			namespace Null
+			{
+				void DebugDrawManager::draw()
+				{
+					//Popping keeps the queue's memory, swapping with an empty queue would allocate a new one every frame
+					while (!drawList.empty())
+						drawList.pop();
+				}
+			}
+		}
+	}
+}
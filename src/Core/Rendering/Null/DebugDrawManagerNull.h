@@ -0,0 +1,30 @@
+﻿#pragma once
+#include "Core/Rendering/DebugDrawManager.h"
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Rendering
+		{
+			namespace Null
+			{
+				//Forward decl
+				class RenderManager;
+
+				/**
+				 * \brief Null implementation of the debug draw manager. Accepts drawables like the other backends, and discards them every frame.
+				 */
+				class DebugDrawManager : public Rendering::DebugDrawManager
+				{
+					friend Null::RenderManager;
+				protected:
+					/**
+					 * \brief Discards the queued drawables
+					 */
+					void draw() override;
+				};
+			}
+		}
+	}
+}
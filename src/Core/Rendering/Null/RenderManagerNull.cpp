@@ -0,0 +1,116 @@
+﻿#include "RenderManagerNull.h"
+#include "DebugDrawManagerNull.h"
+
+#include "Core/UserPrefs.h"
+#include "Core/Transform.h"
+#include "Core/Components/Camera.h"
+#include "Core/Rendering/Components/Renderer.h"
+#include "Core/Rendering/Material.h"
+#include "Editor/JsonSerializer.h"
+#include "Misc/Profiler.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+namespace filesystem = boost::filesystem;
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Rendering
+		{
+			namespace Null
+			{
+				RenderManager::RenderManager()
+				{
+					DebugDrawManager::instance = new Null::DebugDrawManager();
+				}
+
+				RenderManager::~RenderManager()
+				{
+					delete DebugDrawManager::instance;
+					DebugDrawManager::instance = nullptr;
+
+					skyboxes.clear();
+					for (auto m : materials) delete m.second;
+				}
+
+				void RenderManager::render()
+				{
+					TRISTEON_PROFILE_SCOPE("Null::RenderManager::render");
+					//Bring the culling bounds up to date with this frame's transforms
+					updateCulling();
+					drawCalls.clear();
+
+					//Like the other backends, gameplay cameras are only rendered in playmode
+					if (inPlayMode)
+					{
+						//There is no window, the screen size is taken from the user settings instead
+						float const aspect = (float)UserPrefs::getIntValue("SCREENWIDTH") / (float)UserPrefs::getIntValue("SCREENHEIGHT");
+						for (size_t i = 0; i < cameras.size(); i++)
+						{
+							Components::Camera* camera = cameras[i];
+							glm::mat4 const view = camera->getViewMatrix();
+							glm::mat4 const proj = camera->getProjectionMatrix(aspect);
+
+							cull(view, proj, visible);
+							for (Renderer* r : visible)
+								drawCalls.push_back({ i, r->material.get(), r, r->transform.get()->getTransformationMatrix() });
+						}
+
+						//Group the draw calls of every camera by material, as a real backend would to minimize state changes
+						std::sort(drawCalls.begin(), drawCalls.end(), [](const DrawCall& a, const DrawCall& b)
+						{
+							return a.camera != b.camera ? a.camera < b.camera : a.material < b.material;
+						});
+					}
+
+					((Null::DebugDrawManager*)DebugDrawManager::instance)->draw();
+				}
+
+				Rendering::Material* RenderManager::getmaterial(std::string filePath)
+				{
+					TRISTEON_PROFILE_SCOPE("Null::RenderManager::getMaterial");
+					//Try to return the material from our batched materials
+					if (materials.find(filePath) != materials.end())
+						return materials[filePath];
+
+					//Don't even bother doing anything if the material doesn't exist
+					if (!filesystem::exists(filePath))
+						return nullptr;
+
+					//Our materials can only be .mat files
+					if (filesystem::path(filePath).extension() != ".mat")
+						return nullptr;
+
+					Rendering::Material* m = new Rendering::Material();
+					m->deserialize(JsonSerializer::load(filePath));
+					m->updateProperties(true);
+					materials[filePath] = m;
+					return m;
+				}
+
+				Rendering::Skybox* RenderManager::_getSkybox(std::string filePath)
+				{
+					TRISTEON_PROFILE_SCOPE("Null::RenderManager::getSkybox");
+					Rendering::Skybox* skybox = new Rendering::Skybox();
+					skybox->deserialize(JsonSerializer::load(filePath));
+					skyboxes[filePath] = std::unique_ptr<Rendering::Skybox>(skybox);
+					return skybox;
+				}
+
+				void RenderManager::_recompileShader(std::string filePath)
+				{
+					for (const auto mat : materials)
+					{
+						if (mat.second->shaderFilePath == filePath)
+						{
+							mat.second->updateShader();
+							mat.second->updateProperties(true);
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,65 @@
+﻿#pragma once
+#include "Core/Rendering/RenderManager.h"
+
+#include <glm/mat4x4.hpp>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Rendering
+		{
+			namespace Null
+			{
+				/**
+				 * \brief DrawCall describes a single renderer that would be drawn by a camera
+				 */
+				struct DrawCall
+				{
+					/**
+					 * \brief The index of the camera in the camera list
+					 */
+					size_t camera;
+					Material* material;
+					Renderer* renderer;
+					/**
+					 * \brief The model matrix that the renderer would be drawn with
+					 */
+					glm::mat4 model;
+				};
+
+				/**
+				 * \brief Null::RenderManager is a RenderManager without a rendering API, used to run the engine headless (RENDERAPI=NULL).
+				 * It registers renderers and cameras, culls and builds the draw list for every camera like the other backends, but doesn't issue any GPU calls.
+				 */
+				class RenderManager : public Rendering::RenderManager
+				{
+				public:
+					RenderManager();
+					~RenderManager();
+
+					/**
+					 * \brief Culls the scene and builds the draw list for every camera
+					 */
+					void render() override;
+
+					/**
+					 * \brief The draw list of the last frame, sorted by camera and material
+					 */
+					const std::vector<DrawCall>& getDrawCalls() const { return drawCalls; }
+				protected:
+					Rendering::Material* getmaterial(std::string filePath) override;
+					Rendering::Skybox* _getSkybox(std::string filePath) override;
+					void _recompileShader(std::string filePath) override;
+				private:
+					std::vector<DrawCall> drawCalls;
+					/**
+					 * \brief The renderers that passed culling, reused for every camera to avoid allocations
+					 */
+					std::vector<Renderer*> visible;
+				};
+			}
+		}
+	}
+}
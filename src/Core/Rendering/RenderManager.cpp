@@ -4,8 +4,11 @@
 #include "Core/Message.h"
 #include <Core/Components/Camera.h>
 #include <Core/Rendering/Components/Renderer.h>
+#include "Core/Transform.h"
+#include "Math/Frustum.h"
 #include <Misc/Console.h>
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include "Core/BindingData.h"
 namespace filesystem = boost::filesystem;
@@ -18,56 +21,68 @@ namespace Tristeon
 		{
 			RenderManager* RenderManager::instance;
 
-			RenderManager::RenderManager()
+			RenderManager::RenderManager() :
+				cameras(&Components::Camera::registryIndex),
+				renderers(&Renderer::registryIndex),
+				renderables(&UIRenderable::registryIndex)
 			{
 				//Store instance
 				instance = this;
 
 				//Render
-				MessageBus::subscribeToMessage(MT_RENDER, [&](Message msg) { render(); });
+				MessageBus::subscribeToMessage(MT_RENDER, [&](const Message& msg) { render(); });
 
 				//(De)registering of render components
-				MessageBus::subscribeToMessage(MT_RENDERINGCOMPONENT_REGISTER, [&](Message msg) { registerRenderer(msg); });
-				MessageBus::subscribeToMessage(MT_RENDERINGCOMPONENT_DEREGISTER, [&](Message msg) { deregisterRenderer(msg); });
+				MessageBus::subscribeToBatch(MT_RENDERINGCOMPONENT_REGISTER, [&](const Message* msgs, size_t count) { registerRenderers(msgs, count); });
+				MessageBus::subscribeToMessage(MT_RENDERINGCOMPONENT_DEREGISTER, [&](const Message& msg) { deregisterRenderer(msg); });
 
 				//(De)registering of cameras
-				MessageBus::subscribeToMessage(MT_CAMERA_REGISTER, [&](Message msg) { registerCamera(msg); });
-				MessageBus::subscribeToMessage(MT_CAMERA_DEREGISTER, [&](Message msg) { deregisterCamera(msg); });
+				MessageBus::subscribeToMessage(MT_CAMERA_REGISTER, [&](const Message& msg) { registerCamera(msg); });
+				MessageBus::subscribeToMessage(MT_CAMERA_DEREGISTER, [&](const Message& msg) { deregisterCamera(msg); });
 
 				//Game logic
-				MessageBus::subscribeToMessage(MT_GAME_LOGIC_START, [&](Message msg) { inPlayMode = true; });
-				MessageBus::subscribeToMessage(MT_GAME_LOGIC_STOP, [&](Message msg) { inPlayMode = false; });
+				MessageBus::subscribeToMessage(MT_GAME_LOGIC_START, [&](const Message& msg) { inPlayMode = true; });
+				MessageBus::subscribeToMessage(MT_GAME_LOGIC_STOP, [&](const Message& msg) { inPlayMode = false; });
 			}
 
 			std::vector<Renderer*> RenderManager::getRenderers() const
 			{
-				return renderers;
+				return std::vector<Renderer*>(renderers.begin(), renderers.end());
 			}
 
-			TObject* RenderManager::registerRenderer(Message msg)
+			const std::vector<Renderer*>& RenderManager::registerRenderers(const Message* msgs, size_t count)
 			{
-				//Confirm that we're getting useful data
-				Misc::Console::t_assert(msg.userData != nullptr, "Trying to register null renderer!");
-
-				//Check if renderer
-				Renderer* r = dynamic_cast<Renderer*>(msg.userData);
-				if (r != nullptr)
-				{
-					//Successfully found a renderer
-					renderers.push_back(r);
-					//Init
-					r->initInternalRenderer();
-					return r;
-				}
-				else
+				registeredBatch.clear();
+				for (size_t i = 0; i < count; i++)
 				{
+					//Confirm that we're getting useful data
+					Misc::Console::t_assert(msgs[i].userData != nullptr, "Trying to register null renderer!");
+
+					//Check if renderer
+					Renderer* r = dynamic_cast<Renderer*>(msgs[i].userData);
+					if (r != nullptr)
+					{
+						registeredBatch.push_back(r);
+						continue;
+					}
+
 					//Try to get a UI renderable instead
-					UIRenderable* rable = dynamic_cast<UIRenderable*>(msg.userData);
-					Misc::Console::t_assert(rable != nullptr, "Couldn't cast userdata to renderer or ui renderable in registerRenderer()!");
-					renderables.push_back(rable);
+					UIRenderable* rable = dynamic_cast<UIRenderable*>(msgs[i].userData);
+					Misc::Console::t_assert(rable != nullptr, "Couldn't cast userdata to renderer or ui renderable in registerRenderers()!");
+					renderables.add(rable);
+				}
+
+				//Sort the batch by material, so that renderers which share a material end up next to each other
+				std::stable_sort(registeredBatch.begin(), registeredBatch.end(), [](Renderer* a, Renderer* b) { return a->material.get() < b->material.get(); });
+				renderers.add(registeredBatch.data(), registeredBatch.size());
 
-					return rable;
+				//Init, renderers that registered before keep their internal renderer
+				for (Renderer* r : registeredBatch)
+				{
+					if (r->getInternalRenderer() == nullptr)
+						r->initInternalRenderer();
 				}
+				return registeredBatch;
 			}
 
 			TObject* RenderManager::deregisterRenderer(Message msg)
@@ -78,7 +93,13 @@ namespace Tristeon
 				//Check if the given userdata is a renderer, if so, remove from our list
 				Renderer* r = dynamic_cast<Renderer*>(msg.userData);
 				if (r != nullptr)
+				{
 					renderers.remove(r);
+					if (r->cullingProxy != DynamicBVH::nullNode)
+						bvh.remove(r->cullingProxy);
+					r->cullingProxy = DynamicBVH::nullNode;
+					r->boundsDirty = true;
+				}
 				else
 				{
 					//Check if the given userdata is a UIRenderable instead
@@ -98,7 +119,7 @@ namespace Tristeon
 				//Try to cast to camera, add to our list if successful
 				Components::Camera* cam = dynamic_cast<Components::Camera*>(msg.userData);
 				Misc::Console::t_assert(cam != nullptr, "Couldn't cast userdata to camera (registerCamera())!");
-				cameras.push_back(cam);
+				cameras.add(cam);
 				return cam;
 			}
 
@@ -114,6 +135,45 @@ namespace Tristeon
 				return cam;
 			}
 
+			void RenderManager::updateCulling()
+			{
+				cullingStats = CullingStats();
+
+				for (Renderer* r : renderers)
+				{
+					Transform* t = r->transform.get();
+					if (t == nullptr)
+						continue;
+
+					//Only renderers whose transform or bounds have changed need to be updated
+					uint32_t const version = t->getVersion();
+					if (!r->boundsDirty && version == r->boundsVersion)
+						continue;
+					r->boundsDirty = false;
+					r->boundsVersion = version;
+
+					Math::AABB const bounds = r->getBounds().transformed(t->getTransformationMatrix());
+					if (!bounds.isValid())
+					{
+						if (r->cullingProxy != DynamicBVH::nullNode)
+							bvh.remove(r->cullingProxy);
+						r->cullingProxy = DynamicBVH::nullNode;
+					}
+					else if (r->cullingProxy == DynamicBVH::nullNode)
+						r->cullingProxy = bvh.insert(bounds, r);
+					else
+						bvh.update(r->cullingProxy, bounds);
+				}
+			}
+
+			void RenderManager::cull(const glm::mat4& view, const glm::mat4& proj, std::vector<Renderer*>& visible)
+			{
+				visible.clear();
+				cullingStats.tested += bvh.query(Math::Frustum(view, proj), visible);
+				cullingStats.visible += visible.size();
+				cullingStats.culled += bvh.size() - visible.size();
+			}
+
 			void RenderManager::setGridEnabled(bool enable)
 			{
 				this->gridEnabled = enable;
@@ -124,6 +184,20 @@ namespace Tristeon
 				return instance->getmaterial(filePath);
 			}
 
+			CullingStats RenderManager::getCullingStats()
+			{
+				if (instance == nullptr)
+					return CullingStats();
+				return instance->cullingStats;
+			}
+
+			std::vector<GPUTiming> RenderManager::getGPUTimings()
+			{
+				if (instance == nullptr)
+					return {};
+				return instance->gpuTimings;
+			}
+
 			Skybox* RenderManager::getSkybox(std::string filePath)
 			{
 				//Try to return the material from our batched materials
@@ -1,9 +1,10 @@
 ﻿#pragma once
 #include "Misc/Delegate.h"
-#include "Misc/vector.h"
+#include "Misc/Registry.h"
 #include "Skybox.h"
 #include "API/WindowContext.h"
 #include "Core/Rendering/ShaderFile.h"
+#include "Core/Rendering/DynamicBVH.h"
 
 namespace Tristeon
 {
@@ -32,6 +33,63 @@ namespace Tristeon
 				 * \brief Subscribe to this function to implement your render function.
 				 */
 				Misc::Delegate<> onRender;
+				/**
+				 * \brief The index of the renderable in the render manager's renderable registry
+				 */
+				uint32_t registryIndex = UINT32_MAX;
+			};
+
+			/**
+			 * \brief CullingStats describes the results of frustum culling during a frame, summed over every camera that has been rendered.
+			 */
+			struct CullingStats
+			{
+				/**
+				 * \brief The amount of renderers that have been drawn
+				 */
+				size_t visible = 0;
+				/**
+				 * \brief The amount of renderers that have been skipped because they were outside of the frustum
+				 */
+				size_t culled = 0;
+				/**
+				 * \brief The amount of bounding volumes that have been tested against the frustum
+				 */
+				size_t tested = 0;
+			};
+
+			/**
+			 * \brief GPUTiming describes the GPU time of a render pass, or of a stage within a render pass.
+			 */
+			struct GPUTiming
+			{
+				/**
+				 * \brief The name of the pass. Stages are prefixed with the name of their pass, e.g. "Camera 0/Skybox"
+				 */
+				std::string name;
+				/**
+				 * \brief 0 for passes, 1 for the stages of a pass
+				 */
+				uint32_t depth = 0;
+				/**
+				 * \brief The start of the pass or stage in milliseconds, relative to the start of the first pass of the frame
+				 */
+				double start = 0;
+				/**
+				 * \brief The duration of the pass or stage in milliseconds
+				 */
+				double duration = 0;
+
+				/**
+				 * \brief True if the pipeline statistics below have been collected. Statistics are only collected for passes, and only if the GPU supports them
+				 */
+				bool hasStatistics = false;
+				uint64_t inputAssemblyVertices = 0;
+				uint64_t inputAssemblyPrimitives = 0;
+				uint64_t vertexShaderInvocations = 0;
+				uint64_t clippingInvocations = 0;
+				uint64_t clippingPrimitives = 0;
+				uint64_t fragmentShaderInvocations = 0;
 			};
 
 			/**
@@ -70,6 +128,16 @@ namespace Tristeon
 				static Material* getMaterial(std::string filePath);
 
 				static Skybox* getSkybox(std::string filePath);
+
+				/**
+				 * \brief Returns the culling statistics of the last rendered frame
+				 */
+				static CullingStats getCullingStats();
+				/**
+				 * \brief Returns the GPU timings of the most recent frame that the GPU has finished, usually the frame before the last one.
+				 * Empty if the rendering API or the GPU doesn't support timing.
+				 */
+				static std::vector<GPUTiming> getGPUTimings();
 			protected:
 				virtual Skybox* _getSkybox(std::string filePath) = 0;
 				virtual void _recompileShader(std::string filePath) = 0;
@@ -82,10 +150,13 @@ namespace Tristeon
 				virtual Material* getmaterial(std::string filePath) = 0;
 
 				/**
-				 * \brief Registers a renderer to the renderers or UIrenderers list.
-				 * \param msg The message coming from the manager protocol message system. Message.userData is expected to contain our renderer
+				 * \brief Registers a batch of renderers and UI renderables at once. The renderers are sorted by material and added to the renderers list in one go.
+				 * \param msgs The messages coming from the manager protocol message system. Each Message.userData is expected to contain a renderer or UI renderable
+				 * \param count The amount of messages
+				 * \return The renderers that were registered, in the order they were added, so inherited classes can access them when overriding this function.
+				 * Only valid until the next batch is registered.
 				 */
-				virtual TObject* registerRenderer(Message msg);
+				virtual const std::vector<Renderer*>& registerRenderers(const Message* msgs, size_t count);
 				/**
 				 * \brief Deregisters a renderer from the renderers or UIRenderers list.
 				 * \param msg The message coming from the manager protocol message system. Message.userData is expected to contain our renderer
@@ -105,6 +176,19 @@ namespace Tristeon
 				*/
 				virtual Components::Camera* deregisterCamera(Message msg);
 
+				/**
+				 * \brief Brings the bounding volume hierarchy up to date with the renderers that have moved or changed, and resets the culling statistics.
+				 * Should be called once per frame, before cull().
+				 */
+				void updateCulling();
+				/**
+				 * \brief Collects the renderers that are inside of the given camera frustum
+				 * \param view The view matrix of the camera
+				 * \param proj The projection matrix of the camera
+				 * \param visible Filled with the visible renderers, cleared first
+				 */
+				void cull(const glm::mat4& view, const glm::mat4& proj, std::vector<Renderer*>& visible);
+
 				/**
 				 * \brief The renderTechnique renders the cameras and the scene.
 				 */
@@ -113,16 +197,32 @@ namespace Tristeon
 				/**
 				 * \brief The cameras in the current active scene
 				 */
-				vector<Components::Camera*> cameras;
+				Registry<Components::Camera> cameras;
 
 				/**
 				 * \brief The renderers int he current active scene
 				 */
-				Tristeon::vector<Renderer*> renderers;
+				Registry<Renderer> renderers;
+				/**
+				 * \brief The renderers of the last registered batch, kept to reuse its memory
+				 */
+				std::vector<Renderer*> registeredBatch;
+				/**
+				 * \brief The world space bounds of the renderers, used for frustum culling
+				 */
+				DynamicBVH bvh;
+				/**
+				 * \brief The culling statistics of the current frame
+				 */
+				CullingStats cullingStats;
+				/**
+				 * \brief The GPU timings of the last frame that has been read back, filled in by the API specific subclasses
+				 */
+				std::vector<GPUTiming> gpuTimings;
 				/**
 				 * \brief All the UIrenderables
 				 */
-				Tristeon::vector<UIRenderable*> renderables;
+				Registry<UIRenderable> renderables;
 				/**
 				 * \brief All the materials in the project, sorted by their ID
 				 */
@@ -1,5 +1,6 @@
 ﻿#include "ShaderFile.h"
 #include "Misc/Console.h"
+#include "Misc/Profiler.h"
 #include <spirv_cross/spirv_cross.hpp>
 #include "Core/UserPrefs.h"
 #include <fstream>
@@ -28,7 +29,8 @@ namespace Tristeon
 			{
 				//Get the name and the shader file extension of the api
 				std::string apiName, apiExtension;
-				if (api == "VULKAN")
+				//The null backend reflects the Vulkan shaders, so that materials end up with the same properties
+				if (api == "VULKAN" || api == "NULL")
 				{
 					apiName = "Vulkan";
 					apiExtension = ".spv";
@@ -80,8 +82,9 @@ namespace Tristeon
 				fragmentName = tempFragmentName;
 			}
 
-			std::map<int, ShaderProperty> ShaderFile::getProps()
+			const std::map<int, ShaderProperty>& ShaderFile::getProps()
 			{
+				TRISTEON_PROFILE_SCOPE("ShaderFile::getProps");
 				if (loadedProps)
 					return properties;
 
@@ -96,7 +99,7 @@ namespace Tristeon
 				if (!in_vert || !in_vert.good() || !in_frag || !in_frag.good())
 				{
 					Misc::Console::error("Failed to open shader files!");
-					return {};
+					return properties;
 				}
 
 				in_vert.seekg(0, in_vert.end);
@@ -117,7 +117,10 @@ namespace Tristeon
 				*/
 				void deserialize(nlohmann::json json) override;
 
-				std::map<int, ShaderProperty> getProps();
+				/**
+				* \brief Returns the properties of the shader, reflected from the compiled shader the first time they're requested
+				*/
+				const std::map<int, ShaderProperty>& getProps();
 
 				bool hasVariable(int set, int binding, DataType data, ShaderType stage);
 			private:
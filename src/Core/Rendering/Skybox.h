@@ -3,6 +3,7 @@
 #include <Editor/TypeRegister.h>
 #include <glm/mat4x4.hpp>
 #include "Data/Mesh.h"
+#include "Misc/MemoryTracker.h"
 
 #ifdef TRISTEON_EDITOR
 namespace Tristeon {
@@ -19,7 +20,7 @@ namespace Tristeon
 	{
 		namespace Rendering
 		{
-			class Skybox : public TObject
+			class Skybox : public TObject, public Misc::Tracked<Misc::MEM_RENDERING>
 			{
 #ifdef TRISTEON_EDITOR
 				friend Editor::SkyboxFileItem;
@@ -49,7 +49,7 @@ namespace Tristeon
 					device.freeMemory(memory);
 				}
 
-				void BufferVulkan::copyFromData(void* pData)
+				void BufferVulkan::copyFromData(const void* pData)
 				{
 					void* ptr;
 					device.mapMemory(memory, 0, size, {}, &ptr);
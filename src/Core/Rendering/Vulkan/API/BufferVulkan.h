@@ -26,7 +26,7 @@ namespace Tristeon
 					vk::Buffer getBuffer() const { return buffer; }
 					vk::DeviceMemory getDeviceMemory() const { return memory; }
 
-					void copyFromData(void* data);
+					void copyFromData(const void* data);
 					void copyFromBuffer(vk::Buffer srcBuffer, vk::CommandPool cmdPool, vk::Queue graphicsQueue);
 
 					static std::unique_ptr<BufferVulkan> createOptimized(vk::Device device, vk::PhysicalDevice gpu, vk::SurfaceKHR surface, vk::CommandPool cmdPool, vk::Queue graphicsQueue, 
@@ -1,6 +1,7 @@
 ﻿#include "WindowContextVulkan.h"
 
 #include "Misc/Console.h"
+#include "Misc/Profiler.h"
 
 #include <stdint.h>
 #include <vulkan/vulkan.hpp>
@@ -48,6 +49,7 @@ namespace Tristeon
 
 				void WindowContextVulkan::prepareFrame()
 				{
+					TRISTEON_PROFILE_SCOPE("WindowContextVulkan::prepareFrame");
 					//Request image
 					const vk::Result r = device.acquireNextImageKHR(swapchain->getSwapchain(), INT64_MAX, imageAvailable, nullptr, &imgIndex);
 
@@ -60,6 +62,7 @@ namespace Tristeon
 
 				void WindowContextVulkan::finishFrame()
 				{
+					TRISTEON_PROFILE_SCOPE("WindowContextVulkan::finishFrame");
 					//Wait for the device to be finished submitting
 					device.waitIdle();
 
@@ -141,6 +144,10 @@ namespace Tristeon
 					vk::PhysicalDeviceFeatures features = {};
 					features.samplerAnisotropy = VK_TRUE;
 					features.wideLines = VK_TRUE;
+					//Pipeline statistics are only useful if the secondary command buffers that do the drawing can inherit the query
+					const vk::PhysicalDeviceFeatures supported = gpu.getFeatures();
+					features.pipelineStatisticsQuery = supported.pipelineStatisticsQuery && supported.inheritedQueries;
+					features.inheritedQueries = features.pipelineStatisticsQuery;
 
 					//Layers
 					const auto enabledLayerCount = ValidationLayers::validationLayers.size();
@@ -154,6 +161,7 @@ namespace Tristeon
 					vk::DeviceCreateInfo dci = vk::DeviceCreateInfo(vk::DeviceCreateFlags(), qcis.size(), qcis.data(), enabledLayerCount, enabledLayers, extensionCount, enabledExtensions, &features);
 					const vk::Result r = gpu.createDevice(&dci, nullptr, &device);
 					Misc::Console::t_assert(r == vk::Result::eSuccess, "Failed to create logical device!");
+					enabledFeatures = features;
 
 					//Receive queues
 					graphicsQueue = device.getQueue(indices.graphicsFamily, 0);
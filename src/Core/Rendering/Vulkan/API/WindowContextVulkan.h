@@ -36,6 +36,7 @@ namespace Tristeon
 					vk::Semaphore getImageAvailable() const { return imageAvailable; }
 					vk::Semaphore getRenderFinished() const { return renderFinished; }
 					vk::Framebuffer getActiveFramebuffer() const { return swapchain->getFramebufferAt(imgIndex); }
+					vk::PhysicalDeviceFeatures getEnabledFeatures() const { return enabledFeatures; }
 
 				protected:
 					void resize(int width, int height) override;
@@ -57,6 +58,7 @@ namespace Tristeon
 					vk::Device device;
 					vk::Queue presentQueue;
 					vk::Queue graphicsQueue;
+					vk::PhysicalDeviceFeatures enabledFeatures;
 					
 					vk::Semaphore imageAvailable;
 					vk::Semaphore renderFinished;
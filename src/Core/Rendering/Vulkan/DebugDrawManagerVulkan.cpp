@@ -91,14 +91,14 @@ namespace Tristeon
 					pipeline->rebuild(VulkanBindingData::getInstance()->swapchain->extent2D, offscreenPass);
 				}
 
-				void DebugDrawManager::createVertexBuffer(Data::SubMesh mesh, int i)
+				void DebugDrawManager::createVertexBuffer(const Data::Vertex* vertices, size_t vertexCount, int i)
 				{
-					vk::DeviceSize const size = sizeof(Data::Vertex) * mesh.vertices.size();
+					vk::DeviceSize const size = sizeof(Data::Vertex) * vertexCount;
 					if (size == 0)
 						return;
 
 					BufferVulkan staging = BufferVulkan(size, vk::BufferUsageFlagBits::eTransferSrc, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
-					staging.copyFromData(mesh.vertices.data());
+					staging.copyFromData(vertices);
 
 					if (!vertexBuffers[i])
 						vertexBuffers[i] = std::make_unique<BufferVulkan>(size, vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer);
@@ -139,16 +139,14 @@ namespace Tristeon
 						m->setActiveUniformBufferMemory(uniformBuffer->getDeviceMemory());
 						m->render(model, data->view, data->projection);
 
-						Data::SubMesh mesh;
-						mesh.vertices.push_back(l.start);
-						mesh.vertices.push_back(l.end);
+						Data::Vertex const vertices[] = { l.start, l.end };
 
 						if (i >= vertexBuffers.size())
 						{
 							vertexBuffers.push_back(nullptr);
 							vertexBuffersMemory.push_back(nullptr);
 						}
-						createVertexBuffer(mesh, i);
+						createVertexBuffer(vertices, 2, i);
 
 						vk::DeviceSize offsets[1] = { 0 };
 						vk::Buffer vertex = vertexBuffers[i]->getBuffer();
@@ -158,7 +156,7 @@ namespace Tristeon
 						secondary.setLineWidth(l.width);
 
 						//Draw
-						secondary.draw((uint32_t)mesh.vertices.size(), 1, 0, 0);
+						secondary.draw(2, 1, 0, 0);
 
 						drawList.pop();
 						
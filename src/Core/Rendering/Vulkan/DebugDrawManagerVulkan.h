@@ -61,11 +61,12 @@ namespace Tristeon
 					 */
 					void render();
 					/**
-					 * \brief Creates a new vertex buffer in vertexBuffers[i] with the given mesh.
-					 * \param mesh The mesh data that is to be sent to the GPU
+					 * \brief Creates a new vertex buffer in vertexBuffers[i] with the given vertices.
+					 * \param vertices The vertex data that is to be sent to the GPU
+					 * \param vertexCount The amount of vertices
 					 * \param i The index of the vertex buffer
 					 */
-					void createVertexBuffer(Data::SubMesh mesh, int i);
+					void createVertexBuffer(const Data::Vertex* vertices, size_t vertexCount, int i);
 					/**
 					* \brief The shader pipeline
 					*/
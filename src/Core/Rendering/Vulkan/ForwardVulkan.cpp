@@ -1,13 +1,17 @@
 ﻿#include "ForwardVulkan.h"
+#include "Misc/Profiler.h"
+#include "Misc/FrameAllocator.h"
 
 #include <glm/gtc/matrix_transform.inl>
 
 #include "Core/Rendering/Vulkan/RenderManagerVulkan.h"
 #include "InternalMeshRendererVulkan.h"
+#include "Core/Rendering/Components/Renderer.h"
 
 #include "HelperClasses/Pipeline.h"
 #include "HelperClasses/CameraRenderData.h"
 #include "HelperClasses/EditorGrid.h"
+#include "HelperClasses/GPUTimer.h"
 #include "HelperClasses/Swapchain.h"
 #include "DebugDrawManagerVulkan.h"
 #include "SkyboxVulkan.h"
@@ -29,6 +33,7 @@ namespace Tristeon
 
 				void Forward::renderScene(glm::mat4 view, glm::mat4 proj, TObject* info, Rendering::Skybox* skybox)
 				{
+					TRISTEON_PROFILE_SCOPE("Vulkan::Forward::renderScene");
 					//if our camera is null, try and see if we can find it in info
 					CameraRenderData* d = dynamic_cast<CameraRenderData*>(info);
 					if (d == nullptr)
@@ -52,12 +57,20 @@ namespace Tristeon
 					//Begin primary
 					vk::CommandBuffer primary = d->offscreen.cmd;
 					primary.begin(&cmdBegin);
+					GPUTimer* timer = vkRenderManager->gpuTimer;
+					size_t const passIndex = timer->getPassCount();
+					while (cameraPassNames.size() <= passIndex)
+						cameraPassNames.push_back("Camera " + std::to_string(cameraPassNames.size()));
+					GPUTimer::Pass const pass = timer->begin(primary, cameraPassNames[passIndex], 4);
 					primary.beginRenderPass(&renderPassBegin, vk::SubpassContents::eSecondaryCommandBuffers);
 
-					std::vector<vk::CommandBuffer> buffers;
+					//One secondary buffer per visible renderer, plus the grid, debug draw, skybox and stage markers
+					Misc::FrameVector<vk::CommandBuffer> buffers;
+					buffers.reserve(vkRenderManager->internalRenderers.size() + 8);
 
 					//Setup renderdata
-					vk::CommandBufferInheritanceInfo const inheritance = vk::CommandBufferInheritanceInfo(d->offscreen.pass, 0, d->offscreen.buffer); //ignore query
+					//Secondary buffers have to inherit the pipeline statistics query of the pass
+					vk::CommandBufferInheritanceInfo const inheritance = vk::CommandBufferInheritanceInfo(d->offscreen.pass, 0, d->offscreen.buffer, VK_FALSE, vk::QueryControlFlags(), timer->getStatisticFlags());
 					RenderData data;
 					data.inheritance = inheritance;
 					data.viewport = vk::Viewport(0, 0, extent.width, extent.height, 0, 1.0f);
@@ -66,6 +79,14 @@ namespace Tristeon
 					data.projection = proj;
 					data.view = view;
 					data.skyboxSet = skybox != nullptr ? ((Skybox*)skybox)->lightingSet : nullptr;
+
+					//Marks the end of the secondary buffers that have been added so far
+					auto const endStage = [&](const char* name)
+					{
+						vk::CommandBuffer const marker = timer->stage(pass, name, inheritance);
+						if ((VkCommandBuffer)marker != nullptr)
+							buffers.push_back(marker);
+					};
 		
 #ifdef TRISTEON_EDITOR
 					//Draw grid
@@ -78,6 +99,7 @@ namespace Tristeon
 
 						if ((VkCommandBuffer)data.lastUsedSecondaryBuffer != nullptr)
 							buffers.push_back(data.lastUsedSecondaryBuffer);
+						endStage("Grid");
 					}
 #endif
 
@@ -92,19 +114,24 @@ namespace Tristeon
 							if ((VkCommandBuffer)data.lastUsedSecondaryBuffer != nullptr)
 								buffers.push_back(data.lastUsedSecondaryBuffer);
 						}
+						endStage("Debug draw");
 					}
 
-					//Draw scene
-					for (InternalMeshRenderer* r : vkRenderManager->internalRenderers)
+					//Draw the renderers that are inside of the camera frustum
+					vkRenderManager->cull(view, proj, visible);
+					for (Rendering::Renderer* visibleRenderer : visible)
 					{
 						data.lastUsedSecondaryBuffer = nullptr;
 
+						//Vulkan::RenderManager only accepts renderers with a Vulkan internal mesh renderer
+						InternalMeshRenderer* r = static_cast<InternalMeshRenderer*>(visibleRenderer->getInternalRenderer());
 						r->data = &data;
 						r->render();
 
 						if ((VkCommandBuffer)data.lastUsedSecondaryBuffer != nullptr)
 							buffers.push_back(data.lastUsedSecondaryBuffer);
 					}
+					endStage("Renderers");
 
 					//Draw skybox if available
 					if (skybox != nullptr)
@@ -122,17 +149,20 @@ namespace Tristeon
 							if ((VkCommandBuffer)data.lastUsedSecondaryBuffer != nullptr)
 								buffers.push_back(data.lastUsedSecondaryBuffer);
 						}
+						endStage("Skybox");
 					}
 
 					//Execute and finish
 					if (buffers.size() != 0)
 						primary.executeCommands(buffers.size(), buffers.data());
 					primary.endRenderPass();
+					timer->end(primary, pass);
 					primary.end();
 				}
 
 				void Forward::renderCameras()
 				{
+					TRISTEON_PROFILE_SCOPE("Vulkan::Forward::renderCameras");
 					//Swapchain framebuffer
 					vk::Framebuffer const fb = vkRenderManager->getActiveFrameBuffer();
 
@@ -150,6 +180,8 @@ namespace Tristeon
 					vk::CommandBufferBeginInfo cmdBegin = vk::CommandBufferBeginInfo();
 					vk::CommandBuffer primary = vkRenderManager->primaryCmd;
 					primary.begin(&cmdBegin);
+					GPUTimer* timer = vkRenderManager->gpuTimer;
+					GPUTimer::Pass const pass = timer->begin(primary, "Composite", 2);
 	
 					//Begin renderpass
 					vk::RenderPassBeginInfo renderPassBegin = vk::RenderPassBeginInfo(
@@ -158,10 +190,11 @@ namespace Tristeon
 					primary.beginRenderPass(&renderPassBegin, vk::SubpassContents::eSecondaryCommandBuffers);
 
 					//Store secondary buffers, submit in bulk afterwards
-					std::vector<vk::CommandBuffer> buffers;
+					Misc::FrameVector<vk::CommandBuffer> buffers;
+					buffers.reserve(vkRenderManager->cameraData.size() + vkRenderManager->renderables.size() + 2);
 
 					//Store renderdata, used by render objects
-					vk::CommandBufferInheritanceInfo const inheritance = vk::CommandBufferInheritanceInfo(vkRenderManager->vkContext->getRenderpass(), 0, fb); //ignore query
+					vk::CommandBufferInheritanceInfo const inheritance = vk::CommandBufferInheritanceInfo(vkRenderManager->vkContext->getRenderpass(), 0, fb, VK_FALSE, vk::QueryControlFlags(), timer->getStatisticFlags());
 					RenderData data;
 					data.inheritance = inheritance;
 					data.viewport = vk::Viewport(0, 0, extent.width, extent.height, 0, 1.0f);
@@ -185,6 +218,9 @@ namespace Tristeon
 							buffers.push_back(b);
 						}
 					}
+					vk::CommandBuffer const camerasMarker = timer->stage(pass, "Cameras", inheritance);
+					if ((VkCommandBuffer)camerasMarker != nullptr)
+						buffers.push_back(camerasMarker);
 
 					//Draw UI
 					for (UIRenderable* r : vkRenderManager->renderables)
@@ -195,6 +231,9 @@ namespace Tristeon
 						if (data.lastUsedSecondaryBuffer)
 							buffers.push_back(data.lastUsedSecondaryBuffer);
 					}
+					vk::CommandBuffer const uiMarker = timer->stage(pass, "UI", inheritance);
+					if ((VkCommandBuffer)uiMarker != nullptr)
+						buffers.push_back(uiMarker);
 
 					//Execute secondary buffers (all renderable objects)
 					if (buffers.size() != 0)
@@ -202,6 +241,7 @@ namespace Tristeon
 
 					//End the primary renderpass
 					primary.endRenderPass();
+					timer->end(primary, pass);
 					primary.end();
 				}
 			}
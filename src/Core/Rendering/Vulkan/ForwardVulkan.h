@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "Core/Rendering/RenderTechniques/RenderTechnique.h"
+#include <string>
+#include <vector>
 
 namespace Tristeon
 {
@@ -7,6 +9,9 @@ namespace Tristeon
 	{
 		namespace Rendering
 		{
+			//Forward decl
+			class Renderer;
+
 			namespace Vulkan
 			{
 				//Forward decl
@@ -43,6 +48,14 @@ namespace Tristeon
 					 * \brief A reference to Vulkan::RenderManager, for rendering info
 					 */
 					RenderManager* vkRenderManager;
+					/**
+					 * \brief The renderers that passed frustum culling, reused for every camera to avoid allocations
+					 */
+					std::vector<Rendering::Renderer*> visible;
+					/**
+					 * \brief The GPU timer names of the camera passes, by pass index. Created once so that naming a pass doesn't allocate every frame
+					 */
+					std::vector<std::string> cameraPassNames;
 				};
 			}
 		}
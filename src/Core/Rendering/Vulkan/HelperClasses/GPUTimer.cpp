@@ -0,0 +1,251 @@
+﻿#include "GPUTimer.h"
+#include "Misc/Console.h"
+
+#include <algorithm>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Rendering
+		{
+			namespace Vulkan
+			{
+				/**
+				 * The amount of values that a pipeline statistics query returns, one for every flag in statisticFlags
+				 */
+				static const uint32_t statisticCount = 6;
+
+				GPUTimer::GPUTimer(vk::PhysicalDevice gpu, vk::Device device, uint32_t queueFamily, bool pipelineStatistics) : device(device)
+				{
+					//Timestamps are only supported on queues that report valid bits
+					std::vector<vk::QueueFamilyProperties> const families = gpu.getQueueFamilyProperties();
+					uint32_t const validBits = queueFamily < families.size() ? families[queueFamily].timestampValidBits : 0;
+					supported = validBits != 0;
+					if (!supported)
+					{
+						Misc::Console::warning("The GPU doesn't support timestamp queries, GPU timings are disabled");
+						return;
+					}
+
+					timestampPeriod = gpu.getProperties().limits.timestampPeriod;
+					timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+					if (pipelineStatistics)
+					{
+						//Results are returned in the order of the flag bits, see read()
+						statisticFlags = vk::QueryPipelineStatisticFlagBits::eInputAssemblyVertices |
+							vk::QueryPipelineStatisticFlagBits::eInputAssemblyPrimitives |
+							vk::QueryPipelineStatisticFlagBits::eVertexShaderInvocations |
+							vk::QueryPipelineStatisticFlagBits::eClippingInvocations |
+							vk::QueryPipelineStatisticFlagBits::eClippingPrimitives |
+							vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations;
+					}
+
+					vk::CommandPoolCreateInfo const poolInfo = vk::CommandPoolCreateInfo(vk::CommandPoolCreateFlagBits::eResetCommandBuffer, queueFamily);
+					vk::Result r = device.createCommandPool(&poolInfo, nullptr, &commandPool);
+					Misc::Console::t_assert(r == vk::Result::eSuccess, "Failed to create GPU timer command pool: " + to_string(r));
+
+					for (Frame& frame : frames)
+					{
+						vk::QueryPoolCreateInfo const timestampInfo = vk::QueryPoolCreateInfo(vk::QueryPoolCreateFlags(), vk::QueryType::eTimestamp, maxTimestamps);
+						r = device.createQueryPool(&timestampInfo, nullptr, &frame.timestamps);
+						Misc::Console::t_assert(r == vk::Result::eSuccess, "Failed to create timestamp query pool: " + to_string(r));
+
+						if (statisticFlags)
+						{
+							vk::QueryPoolCreateInfo const statisticsInfo = vk::QueryPoolCreateInfo(vk::QueryPoolCreateFlags(), vk::QueryType::ePipelineStatistics, maxPasses, statisticFlags);
+							r = device.createQueryPool(&statisticsInfo, nullptr, &frame.statistics);
+							Misc::Console::t_assert(r == vk::Result::eSuccess, "Failed to create pipeline statistics query pool: " + to_string(r));
+						}
+					}
+				}
+
+				GPUTimer::~GPUTimer()
+				{
+					if (!supported)
+						return;
+
+					for (Frame& frame : frames)
+					{
+						device.destroyQueryPool(frame.timestamps);
+						if (frame.statistics)
+							device.destroyQueryPool(frame.statistics);
+					}
+					//Destroys the marker command buffers as well
+					device.destroyCommandPool(commandPool);
+				}
+
+				void GPUTimer::newFrame(std::vector<GPUTiming>& timings)
+				{
+					if (!supported)
+						return;
+
+					//The GPU has had a frame to finish the previous frame, if it hasn't its results are dropped rather than waited for
+					Frame& previous = frames[frameIndex % framesInFlight];
+					if (previous.passCount != 0 && read(previous, results))
+						timings.swap(results);
+
+					//Reuse the queries of the frame before the previous one, they have been read back last frame
+					frameIndex++;
+					Frame& current = frames[frameIndex % framesInFlight];
+					current.timestampCount = 0;
+					current.passCount = 0;
+					current.markersUsed = 0;
+				}
+
+				GPUTimer::Pass GPUTimer::begin(vk::CommandBuffer cmd, const std::string& name, uint32_t maxStages)
+				{
+					Pass pass;
+					Frame& frame = frames[frameIndex % framesInFlight];
+					//The first and the last timestamp of the pass, and one for every stage
+					uint32_t const count = maxStages + 2;
+					if (!supported || frame.passCount >= maxPasses || frame.timestampCount + count > maxTimestamps)
+						return pass;
+
+					//Reuse the pass at this index from an earlier frame, assigning keeps the memory of its name and stages
+					if (frame.passCount == frame.passes.size())
+						frame.passes.emplace_back();
+					PassData& data = frame.passes[frame.passCount];
+					data.name.assign(name);
+					data.firstTimestamp = frame.timestampCount;
+					data.maxStages = maxStages;
+					data.stages.clear();
+					data.stages.reserve(maxStages);
+					data.ended = false;
+					frame.timestampCount += count;
+
+					//Queries have to be reset before they can be written again. Resets aren't allowed inside of render passes, so the whole pass is reset here
+					cmd.resetQueryPool(frame.timestamps, data.firstTimestamp, count);
+					cmd.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, frame.timestamps, data.firstTimestamp);
+					if (statisticFlags)
+					{
+						uint32_t const query = (uint32_t)frame.passCount;
+						cmd.resetQueryPool(frame.statistics, query, 1);
+						cmd.beginQuery(frame.statistics, query, vk::QueryControlFlags());
+					}
+
+					pass.index = frame.passCount++;
+					pass.valid = true;
+					return pass;
+				}
+
+				vk::CommandBuffer GPUTimer::stage(const Pass& pass, const char* name, const vk::CommandBufferInheritanceInfo& inheritance)
+				{
+					if (!pass.valid)
+						return nullptr;
+
+					Frame& frame = frames[frameIndex % framesInFlight];
+					PassData& data = frame.passes[pass.index];
+					if (data.ended || data.stages.size() >= data.maxStages)
+						return nullptr;
+
+					//Primary command buffers can only execute secondary command buffers inside of the render pass, so the timestamp is written by one
+					if (frame.markersUsed == frame.markers.size())
+					{
+						vk::CommandBufferAllocateInfo const alloc = vk::CommandBufferAllocateInfo(commandPool, vk::CommandBufferLevel::eSecondary, 1);
+						vk::CommandBuffer marker;
+						vk::Result const r = device.allocateCommandBuffers(&alloc, &marker);
+						Misc::Console::t_assert(r == vk::Result::eSuccess, "Failed to allocate GPU timer command buffer: " + to_string(r));
+						frame.markers.push_back(marker);
+					}
+					vk::CommandBuffer marker = frame.markers[frame.markersUsed++];
+
+					data.stages.push_back(name);
+					marker.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eRenderPassContinue | vk::CommandBufferUsageFlagBits::eOneTimeSubmit, &inheritance));
+					marker.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, frame.timestamps, data.firstTimestamp + (uint32_t)data.stages.size());
+					marker.end();
+					return marker;
+				}
+
+				void GPUTimer::end(vk::CommandBuffer cmd, const Pass& pass)
+				{
+					if (!pass.valid)
+						return;
+
+					Frame& frame = frames[frameIndex % framesInFlight];
+					PassData& data = frame.passes[pass.index];
+					if (data.ended)
+						return;
+
+					if (statisticFlags)
+						cmd.endQuery(frame.statistics, (uint32_t)pass.index);
+					cmd.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, frame.timestamps, data.firstTimestamp + (uint32_t)data.stages.size() + 1);
+					data.ended = true;
+				}
+
+				bool GPUTimer::read(const Frame& frame, std::vector<GPUTiming>& timings) const
+				{
+					uint64_t ticks[maxTimestamps];
+					uint64_t frameStart = ~0ull;
+
+					//Timings are written over the existing elements, so that their names keep their memory
+					size_t used = 0;
+					auto const next = [&]() -> GPUTiming&
+					{
+						if (used == timings.size())
+							timings.emplace_back();
+						//Reset everything but the name's memory
+						GPUTiming& timing = timings[used++];
+						std::string name = std::move(timing.name);
+						timing = GPUTiming();
+						timing.name = std::move(name);
+						return timing;
+					};
+
+					for (size_t i = 0; i < frame.passCount; i++)
+					{
+						const PassData& data = frame.passes[i];
+						if (!data.ended)
+							continue;
+
+						//Without the wait flag, eNotReady is returned if any of the queries hasn't finished yet
+						uint32_t const count = (uint32_t)data.stages.size() + 2;
+						vk::Result r = device.getQueryPoolResults(frame.timestamps, data.firstTimestamp, count, sizeof(uint64_t) * count, ticks, sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+						if (r != vk::Result::eSuccess)
+							return false;
+						for (uint32_t t = 0; t < count; t++)
+							ticks[t] &= timestampMask;
+						frameStart = std::min(frameStart, ticks[0]);
+
+						GPUTiming& pass = next();
+						pass.name.assign(data.name);
+						pass.start = (double)ticks[0];
+						pass.duration = (double)(ticks[count - 1] - ticks[0]) * timestampPeriod / 1e6;
+
+						if (statisticFlags)
+						{
+							uint64_t statistics[statisticCount];
+							r = device.getQueryPoolResults(frame.statistics, (uint32_t)i, 1, sizeof(statistics), statistics, sizeof(statistics), vk::QueryResultFlagBits::e64);
+							if (r != vk::Result::eSuccess)
+								return false;
+
+							pass.hasStatistics = true;
+							pass.inputAssemblyVertices = statistics[0];
+							pass.inputAssemblyPrimitives = statistics[1];
+							pass.vertexShaderInvocations = statistics[2];
+							pass.clippingInvocations = statistics[3];
+							pass.clippingPrimitives = statistics[4];
+							pass.fragmentShaderInvocations = statistics[5];
+						}
+
+						//Every stage runs from the end of the previous stage (or the start of the pass) to its own timestamp
+						for (size_t s = 0; s < data.stages.size(); s++)
+						{
+							GPUTiming& stage = next();
+							stage.name.assign(data.name).append("/").append(data.stages[s]);
+							stage.depth = 1;
+							stage.start = (double)ticks[s];
+							stage.duration = (double)(ticks[s + 1] - ticks[s]) * timestampPeriod / 1e6;
+						}
+					}
+					timings.resize(used);
+
+					//Make the start times relative to the first pass of the frame
+					for (GPUTiming& timing : timings)
+						timing.start = (timing.start - (double)frameStart) * timestampPeriod / 1e6;
+					return true;
+				}
+			}
+		}
+	}
+}
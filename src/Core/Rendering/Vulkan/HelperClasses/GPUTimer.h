@@ -0,0 +1,157 @@
+﻿#pragma once
+#include <vulkan/vulkan.hpp>
+#include "Core/Rendering/RenderManager.h"
+
+#include <string>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		namespace Rendering
+		{
+			namespace Vulkan
+			{
+				/**
+				 * \brief GPUTimer measures the GPU time of render passes and of the stages within them using timestamp queries,
+				 * and collects pipeline statistics for every pass if the GPU supports them.
+				 *
+				 * The queries of a frame are read back at the start of the next frame, without waiting for the GPU.
+				 * If they aren't available by then the results of that frame are dropped, and the previous results are kept.
+				 * Only core Vulkan 1.0 queries are used, so that timing works on any driver that reports timestamp support (including software drivers).
+				 * The bookkeeping of passes and results is reused from frame to frame, so timing a frame with the same passes as the last one doesn't allocate.
+				 */
+				class GPUTimer
+				{
+				public:
+					/**
+					 * \brief Describes a pass that is being recorded, returned by begin()
+					 */
+					struct Pass
+					{
+						/**
+						 * \brief The index of the pass in the current frame, only valid if valid is true
+						 */
+						size_t index = 0;
+						/**
+						 * \brief False if the pass isn't being timed, because timestamps aren't supported or because the frame ran out of queries
+						 */
+						bool valid = false;
+					};
+
+					/**
+					 * \brief Creates the query pools
+					 * \param gpu The physical device, used to check for timestamp support
+					 * \param device The logical device
+					 * \param queueFamily The queue family that the timed command buffers are submitted to
+					 * \param pipelineStatistics True if the pipelineStatisticsQuery and inheritedQueries features have been enabled on the device
+					 */
+					GPUTimer(vk::PhysicalDevice gpu, vk::Device device, uint32_t queueFamily, bool pipelineStatistics);
+					~GPUTimer();
+
+					GPUTimer(const GPUTimer&) = delete;
+					GPUTimer& operator=(const GPUTimer&) = delete;
+
+					/**
+					 * \brief Reads back the results of the previous frame and starts a new frame. Has to be called once per frame, before any pass is recorded.
+					 * \param timings Replaced with the results of the previous frame if they were available, by swapping it with the timer's own buffer
+					 */
+					void newFrame(std::vector<GPUTiming>& timings);
+
+					/**
+					 * \brief Starts timing a pass. Has to be called outside of a render pass, right before the pass begins.
+					 * \param cmd The primary command buffer that records the pass
+					 * \param name The name of the pass, copied into memory that is reused by the pass at the same index in later frames
+					 * \param maxStages The maximum amount of times that stage() will be called for this pass
+					 */
+					Pass begin(vk::CommandBuffer cmd, const std::string& name, uint32_t maxStages);
+					/**
+					 * \brief Returns a secondary command buffer that marks the end of a stage of the pass, and the start of the next one.
+					 * Has to be executed inside of the render pass, right after the secondary command buffers of the stage.
+					 * \param pass The pass, as returned by begin()
+					 * \param name The name of the stage. Not copied, has to be a string literal
+					 * \param inheritance The inheritance info of the render pass, see getStatisticFlags()
+					 * \return Returns a null handle if the pass isn't being timed
+					 */
+					vk::CommandBuffer stage(const Pass& pass, const char* name, const vk::CommandBufferInheritanceInfo& inheritance);
+					/**
+					 * \brief Stops timing the pass. Has to be called outside of the render pass, right after the pass has ended.
+					 */
+					void end(vk::CommandBuffer cmd, const Pass& pass);
+
+					/**
+					 * \brief The pipeline statistics that are collected. Secondary command buffers that are executed within a timed pass must inherit these flags.
+					 */
+					vk::QueryPipelineStatisticFlags getStatisticFlags() const { return statisticFlags; }
+					/**
+					 * \brief The amount of passes that have been started in the current frame
+					 */
+					size_t getPassCount() const { return frames[frameIndex % framesInFlight].passCount; }
+
+					/**
+					 * \brief The amount of frames whose queries exist at the same time
+					 */
+					static const uint32_t framesInFlight = 2;
+					/**
+					 * \brief The maximum amount of timestamps and passes per frame
+					 */
+					static const uint32_t maxTimestamps = 256;
+					static const uint32_t maxPasses = 32;
+				private:
+					struct PassData
+					{
+						std::string name;
+						uint32_t firstTimestamp;
+						uint32_t maxStages;
+						std::vector<const char*> stages;
+						bool ended = false;
+					};
+
+					struct Frame
+					{
+						vk::QueryPool timestamps;
+						vk::QueryPool statistics;
+						uint32_t timestampCount = 0;
+						/**
+						 * \brief The passes of the frame are the first passCount elements, the others are kept to be reused
+						 */
+						std::vector<PassData> passes;
+						size_t passCount = 0;
+						/**
+						 * \brief Secondary command buffers that write the timestamps of stages, reused every time the frame comes around
+						 */
+						std::vector<vk::CommandBuffer> markers;
+						size_t markersUsed = 0;
+					};
+
+					/**
+					 * \brief Reads the results of the given frame into timings. Returns false if not all results were available.
+					 */
+					bool read(const Frame& frame, std::vector<GPUTiming>& timings) const;
+
+					/**
+					 * \brief The buffer that results are read into, swapped with the caller's timings once a frame has been read completely
+					 */
+					std::vector<GPUTiming> results;
+
+					vk::Device device;
+					vk::CommandPool commandPool;
+					Frame frames[framesInFlight];
+					uint64_t frameIndex = 0;
+
+					bool supported = false;
+					vk::QueryPipelineStatisticFlags statisticFlags;
+					/**
+					 * \brief The amount of nanoseconds per timestamp tick
+					 */
+					double timestampPeriod = 1;
+					/**
+					 * \brief Masks out the bits of timestamps that aren't valid
+					 */
+					uint64_t timestampMask = ~0ull;
+				};
+			}
+		}
+	}
+}
@@ -29,8 +29,9 @@ namespace Tristeon
 					createCommandBuffers();
 					createUniformBuffer();
 					createDescriptorSets();
-					createVertexBuffer(meshRenderer->mesh.get());
-					createIndexBuffer(meshRenderer->mesh.get());
+					Data::SubMesh const mesh = meshRenderer->mesh.get();
+					createVertexBuffer(mesh);
+					createIndexBuffer(mesh);
 				}
 
 				InternalMeshRenderer::~InternalMeshRenderer()
@@ -43,7 +44,8 @@ namespace Tristeon
 
 				void InternalMeshRenderer::render()
 				{
-					if (meshRenderer->mesh.get().vertices.size() == 0 || meshRenderer->mesh.get().indices.size() == 0)
+					//The counts are cached, getting the mesh through its property would copy it
+					if (vertexCount == 0 || indexCount == 0)
 						return;
 					if ((VkBuffer)vertexBuffer->getBuffer() == VK_NULL_HANDLE || (VkBuffer)indexBuffer->getBuffer() == VK_NULL_HANDLE)
 					{
@@ -76,11 +78,10 @@ namespace Tristeon
 					secondary.bindPipeline(vk::PipelineBindPoint::eGraphics, vkm->pipeline->getPipeline());
 
 					//Descriptor sets
-					std::vector<vk::DescriptorSet> sets = { set, vkm->set };
-					if (data->skyboxSet && vkm->pipeline->getEnableLighting())
-						sets.push_back(data->skyboxSet);
+					vk::DescriptorSet sets[] = { set, vkm->set, data->skyboxSet };
+					uint32_t const setCount = data->skyboxSet && vkm->pipeline->getEnableLighting() ? 3 : 2;
 
-					secondary.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, vkm->pipeline->getPipelineLayout(), 0, sets.size(), sets.data(), 0, nullptr);
+					secondary.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, vkm->pipeline->getPipelineLayout(), 0, setCount, sets, 0, nullptr);
 
 					//Vertex / index buffer
 					vk::Buffer vertexBuffers[] = { vertexBuffer->getBuffer() };
@@ -92,7 +93,7 @@ namespace Tristeon
 					secondary.setLineWidth(2);
 
 					//Draw
-					secondary.drawIndexed(meshRenderer->mesh.get().indices.size(), 1, 0, 0, 0);
+					secondary.drawIndexed(indexCount, 1, 0, 0, 0);
 
 					//Stop secondary cmd buffer
 					secondary.end();
@@ -115,6 +116,7 @@ namespace Tristeon
 
 				void InternalMeshRenderer::createVertexBuffer(Data::SubMesh mesh)
 				{
+					vertexCount = (uint32_t)mesh.vertices.size();
 					vk::DeviceSize const size = sizeof(Data::Vertex) * mesh.vertices.size();
 					if (size == 0)
 						return;
@@ -124,6 +126,7 @@ namespace Tristeon
 
 				void InternalMeshRenderer::createIndexBuffer(Data::SubMesh mesh)
 				{
+					indexCount = (uint32_t)mesh.indices.size();
 					vk::DeviceSize const size = sizeof(uint16_t) * mesh.indices.size();
 					if (size == 0)
 						return;
@@ -47,6 +47,11 @@ namespace Tristeon
 					*/
 					void onMeshChange(Data::SubMesh mesh) override;
 				private:
+					/**
+					 * \brief The index of this object in the render manager's internal renderer registry
+					 */
+					uint32_t registryIndex = UINT32_MAX;
+
 					/**
 					* \brief Creates the uniform buffer, used for passing uniform data to the shaders
 					*/
@@ -78,6 +83,11 @@ namespace Tristeon
 					std::unique_ptr<BufferVulkan> vertexBuffer;
 					std::unique_ptr<BufferVulkan> indexBuffer;
 					std::unique_ptr<BufferVulkan> uniformBuffer;
+					/**
+					 * \brief The amount of vertices and indices in the buffers, stored when the buffers are created
+					 */
+					uint32_t vertexCount = 0;
+					uint32_t indexCount = 0;
 
 					/**
 					 * \brief Allocates the command buffers
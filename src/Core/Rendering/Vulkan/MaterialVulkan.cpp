@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 
 #include "Misc/Console.h"
+#include "Misc/FrameAllocator.h"
 
 #include "HelperClasses/CommandBuffer.h"
 #include "HelperClasses/VulkanImage.h"
@@ -63,14 +64,15 @@ namespace Tristeon
 
 					//TODO: This should be a separate function for recursiveness in structs and such
 					//Other data
-					for (const auto pair : shader->getProps())
+					for (const auto& pair : shader->getProps())
 					{
-						ShaderProperty p = pair.second;
+						const ShaderProperty& p = pair.second;
 
 						if (p.valueType == DT_Unknown || p.size == 0)
 							continue;
 
-						void* mem = malloc(p.size);
+						//Scratch memory for the uniform data, released at the end of the next frame
+						void* mem = Misc::FrameAllocator::allocate(p.size);
 
 						switch (p.valueType)
 						{
@@ -96,11 +98,11 @@ namespace Tristeon
 						}
 						case DT_Struct:
 						{
-							//Cast mem (malloc(p.size)) byte array 
+							//Cast mem (p.size bytes) to a byte array 
 							uint8_t* ptr = reinterpret_cast<uint8_t*>(mem);
 
 							//Fill allocated memory with our data
-							for (auto c : p.children)
+							for (const auto& c : p.children)
 							{
 								switch (c.valueType)
 								{
@@ -132,14 +134,10 @@ namespace Tristeon
 							break;
 						}
 						default:
-						{
-							free(mem);
 							continue;
 						}
-						}
 
 						uniformBuffers[p.name]->copyFromData(mem);
-						free(mem);
 					}
 
 					//Reset so we don't acidentally use the buffer from last object
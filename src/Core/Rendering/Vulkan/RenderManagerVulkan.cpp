@@ -5,6 +5,7 @@
 #include "Core/Message.h"
 #include "Core/UserPrefs.h"
 #include "Misc/Console.h"
+#include "Misc/Profiler.h"
 #include "Math/Vector2.h"
 #include "Core/Transform.h"
 
@@ -18,6 +19,7 @@
 #include "HelperClasses/Pipeline.h"
 #include "HelperClasses/EditorGrid.h"
 #include "HelperClasses/CameraRenderData.h"
+#include "HelperClasses/GPUTimer.h"
 #include "MaterialVulkan.h"
 #include <Core/Rendering/Material.h>
 
@@ -48,16 +50,16 @@ namespace Tristeon
 		{
 			namespace Vulkan
 			{
-				RenderManager::RenderManager() : window(BindingData::getInstance()->window)
+				RenderManager::RenderManager() : window(BindingData::getInstance()->window), internalRenderers(&InternalMeshRenderer::registryIndex)
 				{
-					MessageBus::subscribeToMessage(MT_WINDOW_RESIZE, [&](Message msg)
+					MessageBus::subscribeToMessage(MT_WINDOW_RESIZE, [&](const Message& msg)
 					{
 						Math::Vector2* vec = reinterpret_cast<Math::Vector2*>(msg.userData);
 						resizeWindow(static_cast<int>(vec->x), static_cast<int>(vec->y));
 					});
 
 #ifdef TRISTEON_EDITOR
-					MessageBus::subscribeToMessage(MT_PRERENDER, [&](Message msg) { MessageBus::sendMessage({ MT_SHARE_DATA, &editor }); });
+					MessageBus::subscribeToMessage(MT_PRERENDER, [&](const Message& msg) { MessageBus::sendMessage({ MT_SHARE_DATA, &editor }); });
 #endif
 
 					//Create render technique
@@ -91,6 +93,9 @@ namespace Tristeon
 					if (internalRenderers.size() == 0 && renderables.size() == 0)
 						return;
 					
+					//Collect the GPU timings of the previous frame before its queries are reused
+					gpuTimer->newFrame(gpuTimings);
+
 					windowContext->prepareFrame();
 
 					//Render scene
@@ -127,6 +132,10 @@ namespace Tristeon
 
 				void RenderManager::renderScene()
 				{
+					TRISTEON_PROFILE_SCOPE("Vulkan::RenderManager::renderScene");
+					//Bring the culling bounds up to date with this frame's transforms
+					updateCulling();
+
 					if (!inPlayMode)
 					{
 #ifdef TRISTEON_EDITOR
@@ -183,6 +192,7 @@ namespace Tristeon
 					
 					//Commandpool
 					d.destroyCommandPool(commandPool);
+					delete gpuTimer;
 
 					//Core
 					vkContext = nullptr;
@@ -208,6 +218,10 @@ namespace Tristeon
 					createDescriptorPool();
 					createCommandPool();
 
+					//GPU timing
+					const QueueFamilyIndices indices = QueueFamilyIndices::get(vkContext->getGPU(), vkContext->getSurfaceKHR());
+					gpuTimer = new GPUTimer(vkContext->getGPU(), vkContext->getDevice(), indices.graphicsFamily, vkContext->getEnabledFeatures().pipelineStatisticsQuery);
+
 					//Offscreen/onscreen data
 					prepareOffscreenPass();
 					prepareOnscreenPipeline();
@@ -242,6 +256,7 @@ namespace Tristeon
 
 				void RenderManager::submitCameras()
 				{
+					TRISTEON_PROFILE_SCOPE("Vulkan::RenderManager::submitCameras");
 					vk::Semaphore imgav = vkContext->getImageAvailable();
 
 					//Wait till present queue is ready to receive more commands
@@ -348,6 +363,7 @@ namespace Tristeon
 
 				Rendering::Skybox* RenderManager::_getSkybox(std::string filePath)
 				{
+					TRISTEON_PROFILE_SCOPE("Vulkan::RenderManager::getSkybox");
 					if (filePath == "")
 						return nullptr;
 					if (!filesystem::exists(filePath))
@@ -378,20 +394,20 @@ namespace Tristeon
 					}
 				}
 
-				TObject* RenderManager::registerRenderer(Message msg)
+				const std::vector<Renderer*>& RenderManager::registerRenderers(const Message* msgs, size_t count)
 				{
-					//Get and register internal renderer
-					TObject* o = Rendering::RenderManager::registerRenderer(msg);
-					Renderer* r = dynamic_cast<Renderer*>(o);
-					if (r != nullptr)
+					//Get and register internal renderers
+					const std::vector<Renderer*>& registered = Rendering::RenderManager::registerRenderers(msgs, count);
+					internalRenderers.reserve(internalRenderers.size() + registered.size());
+					for (Renderer* r : registered)
 					{
 						InternalRenderer* internal = r->getInternalRenderer();
 						InternalMeshRenderer* meshr = dynamic_cast<InternalMeshRenderer*>(internal);
 						Console::t_assert(meshr != nullptr, "Render Manager Vulkan received a Renderer with an internal renderer that hasn't been created for Vulkan!");
-						internalRenderers.push_back(meshr);
+						internalRenderers.add(meshr);
 					}
 
-					return o;
+					return registered;
 				}
 
 				TObject* RenderManager::deregisterRenderer(Message msg)
@@ -511,6 +527,7 @@ namespace Tristeon
 
 				Rendering::Material* RenderManager::getmaterial(std::string filePath)
 				{
+					TRISTEON_PROFILE_SCOPE("Vulkan::RenderManager::getMaterial");
 					//Try to return the material from our batched materials
 					if (materials.find(filePath) != materials.end())
 						return materials[filePath];
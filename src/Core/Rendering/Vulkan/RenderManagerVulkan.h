@@ -32,6 +32,7 @@ namespace Tristeon
 				class VulkanCore;
 				class Skybox;
 				class WindowContextVulkan;
+				class GPUTimer;
 
 				/**
 				 * \brief EditorData is a small struct wrapping around  
@@ -124,11 +125,12 @@ namespace Tristeon
 					Rendering::Material* getmaterial(std::string filePath) override;
 
 					/**
-					 * \brief Registers a renderer and its internal renderer. Used as callback function for the manager protocol only.
-					 * \param msg A message containing the renderer in msg.userData
-					 * \return Returns the renderer as TObject so inherited classes can access the newly added renderer when overriding this function
+					 * \brief Registers a batch of renderers and their internal renderers. Used as callback function for the manager protocol only.
+					 * \param msgs The messages, each containing a renderer or UI renderable in msg.userData
+					 * \param count The amount of messages
+					 * \return Returns the registered renderers so inherited classes can access them when overriding this function
 					 */
-					TObject* registerRenderer(Message msg) override;
+					const std::vector<Renderer*>& registerRenderers(const Message* msgs, size_t count) override;
 					/**
 					 * \brief Deregisters a renderer and its internal renderer. Used as callback function for the manager protocol only.
 					 * \param msg A message containing the renderer in msg.userData
@@ -204,8 +206,12 @@ namespace Tristeon
 					vk::DescriptorPool descriptorPool;
 
 					vk::CommandBuffer primaryCmd;
+					/**
+					 * \brief Times the offscreen and onscreen passes, read back into gpuTimings
+					 */
+					GPUTimer* gpuTimer = nullptr;
 
-					vector<InternalMeshRenderer*> internalRenderers;
+					Registry<InternalMeshRenderer> internalRenderers;
 					std::map<Components::Camera*, CameraRenderData*> cameraData;
 					ObjectPool<CameraRenderData*> cameraDataPool;
 #ifdef TRISTEON_EDITOR
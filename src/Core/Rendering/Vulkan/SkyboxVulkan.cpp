@@ -1,4 +1,5 @@
 ﻿#include "SkyboxVulkan.h"
+#include "Misc/Profiler.h"
 
 #include <gli/texture_cube.hpp>
 #include <gli/core/load.inl>
@@ -39,6 +40,7 @@ namespace Tristeon
 
 				void Skybox::init()
 				{
+					TRISTEON_PROFILE_SCOPE("Vulkan::Skybox::init");
 					setupCubemap();
 					if (!cubemapLoaded)
 					{
@@ -1,19 +1,67 @@
 ﻿#include <Core/TObject.h>
 #include "Misc/Console.h"
-#include "Misc/StringUtils.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
 
 namespace Tristeon
 {
 	namespace Core
 	{
+		/**
+		 * Scrambles x, every input maps to a unique output
+		 */
+		static uint64_t splitmix64(uint64_t x)
+		{
+			x += 0x9E3779B97F4A7C15ull;
+			x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+			x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+			return x ^ (x >> 31);
+		}
+
+		uint64_t TObject::generateInstanceID()
+		{
+			static std::atomic<uint64_t> counter { ((uint64_t)std::random_device()() << 32) ^ (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count() };
+
+			uint64_t id;
+			do
+			{
+				id = splitmix64(counter.fetch_add(1, std::memory_order_relaxed));
+			} while (id == 0);
+			return id;
+		}
+
 		TObject::TObject()
 		{
-			instanceID = StringUtils::generateRandom(12);
+			instanceID = generateInstanceID();
 		}
 
 		std::string TObject::getInstanceID() const
 		{
-			return instanceID;
+			static const char digits[] = "0123456789abcdef";
+			std::string result(16, '0');
+			for (int i = 15, shift = 0; i >= 0; i--, shift += 4)
+				result[i] = digits[(instanceID >> shift) & 0xF];
+			return result;
+		}
+
+		uint64_t TObject::parseInstanceID(const std::string& instanceID)
+		{
+			if (instanceID.empty() || instanceID == "null")
+				return 0;
+
+			if (instanceID.size() == 16 && instanceID.find_first_not_of("0123456789abcdef") == std::string::npos)
+				return std::stoull(instanceID, nullptr, 16);
+
+			//Legacy instanceIDs were random strings, a FNV-1a hash maps them to the same number every time
+			uint64_t hash = 0xCBF29CE484222325ull;
+			for (char const c : instanceID)
+			{
+				hash ^= (unsigned char)c;
+				hash *= 0x100000001B3ull;
+			}
+			return hash != 0 ? hash : 1;
 		}
 
 		void TObject::print(std::string data)
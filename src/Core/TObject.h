@@ -1,31 +1,55 @@
 ﻿#pragma once
 #include <string>
+#include <cstdint>
 #include "Editor/Serializable.h"
 
 namespace Tristeon
 {
+	namespace Scenes { class BinaryScene; class Scene; }
 	namespace Core
 	{
 		/**
 		 * TObject is the base class of all Tristeon classes.
-		 * Every TObject contains a name and a instanceID. The instanceID is a unique string generated upon creation or loaded in through serialization.
+		 * Every TObject contains a name and a instanceID. The instanceID is a unique 64-bit number generated upon creation or loaded in through serialization.
+		 * The string form of the instanceID is only used for serialization.
 		 */
 		class TObject : public Serializable
 		{
 			friend class Transform;
 			friend class GameObject;
+			friend Scenes::BinaryScene;
+			friend Scenes::Scene;
 		public:
 			TObject();
 
 			std::string name;
+			/**
+			 * Returns the string form of the instanceID, as it is serialized
+			 */
 			std::string getInstanceID() const;
+			/**
+			 * Returns the instanceID. Never 0.
+			 */
+			uint64_t getID() const { return instanceID; }
+
+			/**
+			 * Converts the serialized string form of an instanceID back to its number.
+			 * Supports the 16 digit hexadecimal form written by getInstanceID(), other (legacy) strings are hashed consistently.
+			 * Returns 0 for "null" and empty strings.
+			 */
+			static uint64_t parseInstanceID(const std::string& instanceID);
 
 			/**
 			 * Prints the given data to the console. Only in Debug/ReleaseDebug/Editor.
 			 */
 			static void print(std::string data);
 		private:
-			std::string instanceID;
+			/**
+			 * Returns a new unique instanceID. The counter is seeded once per run, so IDs of different runs don't overlap.
+			 */
+			static uint64_t generateInstanceID();
+
+			uint64_t instanceID;
 		};
 	}
 }
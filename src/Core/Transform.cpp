@@ -9,16 +9,35 @@ namespace Tristeon
 	{
 		REGISTER_TYPE_CPP(Transform)
 
+		Transform::Transform()
+		{
+			index = TransformStore::create(this);
+		}
+
 		Transform::~Transform()
+		{
+			detach();
+			TransformStore::destroy(index);
+		}
+
+		void Transform::detach()
 		{
 			//Remove all our children
 			for (int i = 0; i < children.size(); i++)
+			{
 				children[i]->parent = nullptr;
+				children[i]->setDirty();
+			}
 			children.clear();
 
 			if (parent != nullptr)
+			{
 				parent->children.remove(this);
+				TransformStore::setHierarchyChanged();
+				setDirty();
+			}
 			parent = nullptr;
+			parentID = 0;
 		}
 
 		void Transform::setParent(Transform* parent, bool keepWorldTransform)
@@ -34,6 +53,7 @@ namespace Tristeon
 			//Add ourselves to the new parent
 			if (parent != nullptr)
 				parent->children.push_back(this);
+			TransformStore::setHierarchyChanged();
 
 			if (keepWorldTransform)
 			{
@@ -43,6 +63,7 @@ namespace Tristeon
 				Math::Quaternion const oldGlobalRot = rotation.get();
 
 				this->parent = parent;
+				setDirty();
 
 				//Reset transform
 				position.set(oldGlobalPos);
@@ -52,6 +73,7 @@ namespace Tristeon
 			else
 			{
 				this->parent = parent;
+				setDirty();
 			}
 		}
 
@@ -61,23 +83,34 @@ namespace Tristeon
 			output["typeID"] = TRISTEON_TYPENAME(Transform);
 			output["instanceID"] = getInstanceID();
 			output["parentID"] = parent == nullptr ? "null" : parent->getInstanceID();
-			output["localPosition"] = _localPosition.serialize();
-			output["localScale"] = _localScale.serialize();
-			output["localRotation"] = _localRotation.eulerAngles().serialize();
+			output["localPosition"] = getLocalPosition().serialize();
+			output["localScale"] = getLocalScale().serialize();
+			output["localRotation"] = getLocalRotation().eulerAngles().serialize();
 			return output;
 		}
 
 		void Transform::deserialize(nlohmann::json json)
 		{
 			const std::string instanceIDValue = json["instanceID"];
-			instanceID = instanceIDValue;
+			instanceID = parseInstanceID(instanceIDValue);
 			const std::string parentIDValue = json["parentID"];
-			parentID = parentIDValue;
-			_localPosition.deserialize(json["localPosition"]);
-			_localScale.deserialize(json["localScale"]);
+			parentID = parseInstanceID(parentIDValue);
+			Math::Vector3 pos;
+			pos.deserialize(json["localPosition"]);
+			Math::Vector3 scale;
+			scale.deserialize(json["localScale"]);
 			Math::Vector3 eulerAngles;
 			eulerAngles.deserialize(json["localRotation"]);
-			_localRotation = Math::Quaternion::euler(eulerAngles);
+
+			setLocalTransform(Vec_Convert3(pos), Vec_Convert3(scale), Math::Quaternion::euler(eulerAngles).getGLMQuat());
+		}
+
+		void Transform::setLocalTransform(const glm::vec3& position, const glm::vec3& scale, const glm::quat& rotation)
+		{
+			TransformStore::localPositions[index] = position;
+			TransformStore::localScales[index] = scale;
+			TransformStore::localRotations[index] = rotation;
+			onLocalChange();
 		}
 
 		Math::Vector3 Transform::transformPoint(Math::Vector3 point)
@@ -88,7 +121,7 @@ namespace Tristeon
 
 		Math::Vector3 Transform::inverseTransformPoint(Math::Vector3 point)
 		{
-			glm::vec4 const res = glm::vec4(point.x, point.y, point.z, 1.0) *  inverse(getTransformationMatrix());
+			glm::vec4 const res = glm::vec4(point.x, point.y, point.z, 1.0) * getInverseTransformationMatrix();
 			return{ res.x, res.y, res.z };
 		}
 
@@ -122,10 +155,45 @@ namespace Tristeon
 			return transformPoint(Math::Vector3::forward);
 		}
 
+		Math::Vector3 Transform::getLocalPosition() const
+		{
+			glm::vec3 const& pos = TransformStore::localPositions[index];
+			return Vec_Convert3(pos);
+		}
+
+		void Transform::setLocalPosition(Math::Vector3 pos)
+		{
+			TransformStore::localPositions[index] = Vec_Convert3(pos);
+			onLocalChange();
+		}
+
+		Math::Vector3 Transform::getLocalScale() const
+		{
+			glm::vec3 const& scale = TransformStore::localScales[index];
+			return Vec_Convert3(scale);
+		}
+
+		void Transform::setLocalScale(Math::Vector3 scale)
+		{
+			TransformStore::localScales[index] = Vec_Convert3(scale);
+			onLocalChange();
+		}
+
+		Math::Quaternion Transform::getLocalRotation() const
+		{
+			return Math::Quaternion(TransformStore::localRotations[index]);
+		}
+
+		void Transform::setLocalRotation(Math::Quaternion rot)
+		{
+			TransformStore::localRotations[index] = rot.getGLMQuat();
+			onLocalChange();
+		}
+
 		Math::Vector3 Transform::getGlobalPosition()
 		{
 			if (parent == nullptr)
-				return _localPosition;
+				return getLocalPosition();
 			else
 				return Vec_Convert3(getTransformationMatrix()[3]);
 		}
@@ -133,77 +201,54 @@ namespace Tristeon
 		void Transform::setGlobalPosition(Math::Vector3 pos)
 		{
 			if (parent == nullptr)
-				_localPosition = pos;
+				setLocalPosition(pos);
 			else
-				_localPosition = parent->inverseTransformPoint(pos);
+				setLocalPosition(parent->inverseTransformPoint(pos));
 		}
 
 		Math::Vector3 Transform::getGlobalScale()
 		{
 			if (parent == nullptr)
-				return _localScale;
-
-			//Get scale off our transformation matrix
-			glm::mat4 const trans = getTransformationMatrix();
-
-			glm::vec3 scale;
-			//Unused variables but required in the function
-			glm::quat rotation;
-			glm::vec3 translation;
-			glm::vec3 skew;
-			glm::vec4 perspective;
-			decompose(trans, scale, rotation, translation, skew, perspective);
+				return getLocalScale();
 
+			//Get scale off our (cached) transformation matrix
+			updateGlobalValues();
+			glm::vec3 const& scale = TransformStore::globalScales[index];
 			return Vec_Convert3(scale);
 		}
 
 		void Transform::setGlobalScale(Math::Vector3 scale)
 		{
 			if (parent == nullptr)
-				_localScale = scale;
+				setLocalScale(scale);
 			else
 			{
-				glm::mat4 const p = parent->getTransformationMatrix();
-
-				glm::vec3 s;
-				glm::quat r;
-				glm::vec3 t;
-				glm::vec3 sk;
-				glm::vec4 per;
-				decompose(p, s, r, t, sk, per);
+				parent->updateGlobalValues();
+				glm::vec3 const s = TransformStore::globalScales[parent->index];
 
 				//New localscale, defined as x
 				//x * parent = goal //When we multiply our new localscale with parent it should equal to our goal
 				//x = goal / parent //Which means that we can define x as this
 				//so
 				//_localScale = scale / parent
-				_localScale = scale / Math::Vector3(s.x, s.y, s.z);
+				setLocalScale(scale / Math::Vector3(s.x, s.y, s.z));
 			}
 		}
 
 		Math::Quaternion Transform::getGlobalRotation()
 		{
 			if (parent == nullptr)
-				return _localRotation;
-
-			//Get global rotation off our matrix
-			glm::mat4 const trans = getTransformationMatrix();
-			glm::quat rotation;
-
-			//Unused variables, required for the function
-			glm::vec3 scale;
-			glm::vec3 translation;
-			glm::vec3 skew;
-			glm::vec4 perspective;
-			decompose(trans, scale, rotation, translation, skew, perspective);
+				return getLocalRotation();
 
-			return Math::Quaternion(rotation);
+			//Get global rotation off our (cached) matrix
+			updateGlobalValues();
+			return Math::Quaternion(TransformStore::globalRotations[index]);
 		}
 
 		void Transform::setGlobalRotation(Math::Quaternion rot)
 		{
 			if (parent == nullptr)
-				_localRotation = rot;
+				setLocalRotation(rot);
 			else
 			{
 				//Throwaway values
@@ -211,13 +256,12 @@ namespace Tristeon
 				glm::vec3 translation;
 				glm::vec3 skew;
 				glm::vec4 perspective;
+				glm::quat rotation;
 
 				//Get parent info
-				glm::mat4 const p = parent->getTransformationMatrix();
-				glm::quat rotation;
-				decompose(p, scale, rotation, translation, skew, perspective);
+				parent->updateGlobalValues();
 
-				glm::mat4 const pr = glm::mat4(rotation);			//Parent rotation
+				glm::mat4 const pr = glm::mat4(TransformStore::globalRotations[parent->index]);	//Parent rotation
 				glm::mat4 const gl = glm::mat4(rot.getGLMQuat());	//Goal rotation
 
 				//Local needs to be x so that
@@ -228,24 +272,69 @@ namespace Tristeon
 
 				//Local rotation
 				glm::quat const local = rotation;
-				_localRotation = Math::Quaternion(local);
+				setLocalRotation(Math::Quaternion(local));
 			}
 		}
 
 		glm::mat4 Transform::getTransformationMatrix()
 		{
-			//Get parent transformation (recursive)
-			glm::mat4 p = glm::mat4(1.0f);
+			uint8_t& flags = TransformStore::flags[index];
+			if (!(flags & TF_WORLD_DIRTY))
+				return TransformStore::worldMatrices[index];
+
+			//Get parent transformation (recursive, but only parents that are dirty themselves will recalculate)
+			glm::mat4 const local = TransformStore::getLocalMatrix(index);
 			if (parent != nullptr)
-				p *= parent->getTransformationMatrix();
+				TransformStore::worldMatrices[index] = local * parent->getTransformationMatrix();
+			else
+				TransformStore::worldMatrices[index] = local;
 
-			//Get transformation
-			glm::mat4 const t = glm::translate(glm::mat4(1.0f), Vec_Convert3(localPosition.get()));
-			glm::mat4 const r = glm::mat4(localRotation.get().getGLMQuat());
-			glm::mat4 const s = glm::scale(glm::mat4(1.0f), Vec_Convert3(localScale.get()));
+			flags &= ~TF_WORLD_DIRTY;
+			return TransformStore::worldMatrices[index];
+		}
+
+		glm::mat4 Transform::getInverseTransformationMatrix()
+		{
+			uint8_t& flags = TransformStore::flags[index];
+			if (flags & TF_INVERSE_DIRTY)
+			{
+				TransformStore::inverseWorldMatrices[index] = glm::inverse(getTransformationMatrix());
+				flags &= ~TF_INVERSE_DIRTY;
+			}
+			return TransformStore::inverseWorldMatrices[index];
+		}
+
+		void Transform::updateGlobalValues()
+		{
+			if (!(TransformStore::flags[index] & TF_GLOBAL_DIRTY))
+				return;
+
+			//Unused variables but required in the function
+			glm::vec3 translation;
+			glm::vec3 skew;
+			glm::vec4 perspective;
+			decompose(getTransformationMatrix(), TransformStore::globalScales[index], TransformStore::globalRotations[index], translation, skew, perspective);
+
+			TransformStore::flags[index] &= ~TF_GLOBAL_DIRTY;
+		}
+
+		void Transform::onLocalChange()
+		{
+			TransformStore::flags[index] |= TF_LOCAL_DIRTY;
+			setDirty();
+		}
+
+		void Transform::setDirty()
+		{
+			//Our children can only be clean if we are, so there's nothing left to do
+			uint8_t& flags = TransformStore::flags[index];
+			if (flags & TF_WORLD_DIRTY)
+				return;
 
-			//Apply and return
-			return t * r * s * p;
+			flags |= TF_WORLD_DIRTY | TF_INVERSE_DIRTY | TF_GLOBAL_DIRTY;
+			TransformStore::versions[index]++;
+			for (Transform* child : children)
+				child->setDirty();
 		}
 
 		void Transform::rotate(Math::Vector3 axis, float rot)
@@ -255,7 +344,7 @@ namespace Tristeon
 
 		void Transform::translate(Math::Vector3 t)
 		{
-			localPosition = localPosition.get() + t;
+			setLocalPosition(getLocalPosition() + t);
 		}
 
 		void Transform::translate(float x, float y, float z)
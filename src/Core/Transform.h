@@ -6,61 +6,67 @@
 #include "Misc/vector.h"
 #include <glm/mat4x4.hpp>
 #include "Math/Quaternion.h"
+#include "TransformStore.h"
 
 namespace Tristeon
 {
-	namespace Scenes { class SceneManager; }
+	namespace Scenes { class SceneManager; class BinaryScene; class Scene; }
 	namespace Core
 	{
 		/**
 		 * Transform is a class used to describe the translation, rotation and scale of an object.
 		 * It's usually contained by GameObject, although its usage is not limited to GameObjects.
 		 * Transform also describes parent-child relationships.
+		 *
+		 * The transformation data itself lives in the TransformStore, Transform only holds an index into it.
 		 */
 		class Transform final : public TObject
 		{
 			friend Scenes::SceneManager;
+			friend Scenes::BinaryScene;
+			friend Scenes::Scene;
+			friend TransformStore;
 		public:
+			Transform();
+			Transform(const Transform&) = delete;
+			Transform& operator=(const Transform&) = delete;
 			~Transform();
 
 			/**
 			 * The global position of this transform.
-			 * Warning: This value is currently not cached and will do multiple matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
+			 * The value is cached and only recalculated after this transform or one of its parents has changed.
 			 */
 			Property(Transform, position, Math::Vector3);
 			GetProperty(position) { return getGlobalPosition(); }
 			SetProperty(position) { setGlobalPosition(value); }
 
 			Property(Transform, localPosition, Math::Vector3);
-			GetProperty(localPosition) { return _localPosition; }
-			SetProperty(localPosition) { _localPosition = value; }
+			GetProperty(localPosition) { return getLocalPosition(); }
+			SetProperty(localPosition) { setLocalPosition(value); }
 
 			/**
 			 * The global scale of this transform.
-			 * Warning: This value is currently not cached and will do multiple matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
+			 * The value is cached and only recalculated after this transform or one of its parents has changed.
 			 */
 			Property(Transform, scale, Math::Vector3);
 			GetProperty(scale) { return getGlobalScale(); }
 			SetProperty(scale) { setGlobalScale(value); }
 
 			Property(Transform, localScale, Math::Vector3);
-			GetProperty(localScale) { return _localScale; }
-			SetProperty(localScale) { _localScale = value; }
+			GetProperty(localScale) { return getLocalScale(); }
+			SetProperty(localScale) { setLocalScale(value); }
 
 			/**
 			 * The global rotation of this transform.
-			 * Warning: This value is currently not cached and will do multiple matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
+			 * The value is cached and only recalculated after this transform or one of its parents has changed.
 			 */
 			Property(Transform, rotation, Math::Quaternion);
 			GetProperty(rotation) { return getGlobalRotation(); }
 			SetProperty(rotation) { setGlobalRotation(value); }
 
 			Property(Transform, localRotation, Math::Quaternion);
-			GetProperty(localRotation) { return _localRotation; }
-			SetProperty(localRotation) { _localRotation = value; }
+			GetProperty(localRotation) { return getLocalRotation(); }
+			SetProperty(localRotation) { setLocalRotation(value); }
 
 			/**
 			 * Sets the parent of this transform. Use nullptr to remove the current parent relationship.
@@ -75,10 +81,20 @@ namespace Tristeon
 
 			/**
 			 * Returns a transformation matrix based on the position, scale, rotation and parent hierarchy of this transform.
-			 * Warning: Transformation matrices aren't cached and might do multiple recursive matrix calculations, 
-			 * which might turn this function into an expensive operation depending on the hierarchy depth.
+			 * The matrix is cached, only the transforms that have been marked dirty since the last call are recalculated.
+			 * Dirty matrices are also recalculated in bulk by the TransformStore once per frame.
 			 */
 			glm::mat4 getTransformationMatrix();
+			/**
+			 * Returns a counter that changes whenever the transformation matrix of this transform (or one of its parents) changes.
+			 * Allows systems that cache data derived from the matrix to detect that it's outdated without recalculating it.
+			 */
+			uint32_t getVersion() const { return TransformStore::versions[index]; }
+
+			/**
+			 * Returns the inverse of the transformation matrix. Cached alongside the transformation matrix.
+			 */
+			glm::mat4 getInverseTransformationMatrix();
 
 			/**
 			 * Globally rotates around axis [axis] with rotation [rot]
@@ -97,14 +113,10 @@ namespace Tristeon
 
 			/**
 			 * Transforms a given point from local to global space.
-			 * Warning: This function will do multiple recursive matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
 			 */
 			Math::Vector3 transformPoint(Math::Vector3 point);
 			/**
 			 * Transforms a given point from global to local space
-			 * Warning: This function will do multiple recursive matrix calculations,
-			 * and might be an expensive operation depending on the hierarchy depth.
 			 */
 			Math::Vector3 inverseTransformPoint(Math::Vector3 point);
 
@@ -131,6 +143,13 @@ namespace Tristeon
 			nlohmann::json serialize() override;
 			void deserialize(nlohmann::json json) override;
 		private:
+			Math::Vector3 getLocalPosition() const;
+			void setLocalPosition(Math::Vector3 pos);
+			Math::Vector3 getLocalScale() const;
+			void setLocalScale(Math::Vector3 scale);
+			Math::Quaternion getLocalRotation() const;
+			void setLocalRotation(Math::Quaternion rot);
+
 			Math::Vector3 getGlobalPosition();
 			void setGlobalPosition(Math::Vector3 pos);
 			Math::Vector3 getGlobalScale();
@@ -138,14 +157,39 @@ namespace Tristeon
 			Math::Quaternion getGlobalRotation();
 			void setGlobalRotation(Math::Quaternion rot);
 
-			Math::Vector3 _localPosition = { 0, 0, 0 };
-			Math::Vector3 _localScale = { 1, 1, 1 };
-			Math::Quaternion _localRotation = {};
+			/**
+			 * Removes this transform from its parent and detaches all of its children
+			 */
+			void detach();
+
+			/**
+			 * Sets all local values at once, used when loading
+			 */
+			void setLocalTransform(const glm::vec3& position, const glm::vec3& scale, const glm::quat& rotation);
+
+			/**
+			 * Marks the local matrix as outdated, and with it the world matrices of this transform and its children.
+			 */
+			void onLocalChange();
+			/**
+			 * Marks the world matrix of this transform and all of its children as outdated.
+			 * A dirty transform always has dirty children, which allows us to stop early.
+			 */
+			void setDirty();
+			/**
+			 * Decomposes the world matrix into the cached global scale and rotation, if outdated.
+			 */
+			void updateGlobalValues();
+
+			/**
+			 * The index of our data in the TransformStore. Updated by the store whenever our data is moved.
+			 */
+			uint32_t index = 0;
 
 			/**
-			 * The id of the parent. Used to assign parent child relationships through a lookup in the scene.
+			 * The instanceID of the parent, 0 if there is none. Used to assign parent child relationships through a lookup in the scene.
 			 */
-			std::string parentID = "null";
+			uint64_t parentID = 0;
 
 			Transform* parent = nullptr;
 			Tristeon::vector<Transform*> children;
@@ -0,0 +1,203 @@
+﻿#include "TransformStore.h"
+#include "Transform.h"
+#include "JobSystem.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		std::vector<glm::vec3> TransformStore::localPositions;
+		std::vector<glm::vec3> TransformStore::localScales;
+		std::vector<glm::quat> TransformStore::localRotations;
+		std::vector<glm::mat4> TransformStore::localMatrices;
+		std::vector<glm::mat4> TransformStore::worldMatrices;
+		std::vector<glm::mat4> TransformStore::inverseWorldMatrices;
+		std::vector<glm::vec3> TransformStore::globalScales;
+		std::vector<glm::quat> TransformStore::globalRotations;
+		std::vector<int32_t> TransformStore::parents;
+		std::vector<uint8_t> TransformStore::flags;
+		std::vector<uint32_t> TransformStore::versions;
+		std::vector<Transform*> TransformStore::owners;
+		std::vector<std::pair<size_t, size_t>> TransformStore::rootRanges;
+		bool TransformStore::orderDirty = false;
+
+		/**
+		 * Reorders v so that v[i] becomes the old v[from[i]]
+		 */
+		template <typename T>
+		static void permute(std::vector<T>& v, const std::vector<uint32_t>& from)
+		{
+			std::vector<T> result;
+			result.reserve(v.size());
+			for (uint32_t const i : from)
+				result.push_back(v[i]);
+			v.swap(result);
+		}
+
+		uint32_t TransformStore::create(Transform* owner)
+		{
+			uint32_t const index = (uint32_t)owners.size();
+
+			localPositions.push_back({ 0, 0, 0 });
+			localScales.push_back({ 1, 1, 1 });
+			localRotations.push_back({});
+			localMatrices.push_back(glm::mat4(1.0f));
+			worldMatrices.push_back(glm::mat4(1.0f));
+			inverseWorldMatrices.push_back(glm::mat4(1.0f));
+			globalScales.push_back({ 1, 1, 1 });
+			globalRotations.push_back({});
+			parents.push_back(-1);
+			flags.push_back(TF_ALL_DIRTY);
+			versions.push_back(0);
+			owners.push_back(owner);
+
+			//New transforms are roots, appending a root keeps the depth-first order intact
+			if (!orderDirty)
+				rootRanges.push_back({ index, index + 1 });
+			return index;
+		}
+
+		void TransformStore::destroy(uint32_t index)
+		{
+			//Move the last entry into the freed slot
+			size_t const last = owners.size() - 1;
+			if (index != last)
+			{
+				localPositions[index] = localPositions[last];
+				localScales[index] = localScales[last];
+				localRotations[index] = localRotations[last];
+				localMatrices[index] = localMatrices[last];
+				worldMatrices[index] = worldMatrices[last];
+				inverseWorldMatrices[index] = inverseWorldMatrices[last];
+				globalScales[index] = globalScales[last];
+				globalRotations[index] = globalRotations[last];
+				flags[index] = flags[last];
+				versions[index] = versions[last];
+				owners[index] = owners[last];
+				owners[index]->index = index;
+			}
+
+			localPositions.pop_back();
+			localScales.pop_back();
+			localRotations.pop_back();
+			localMatrices.pop_back();
+			worldMatrices.pop_back();
+			inverseWorldMatrices.pop_back();
+			globalScales.pop_back();
+			globalRotations.pop_back();
+			parents.pop_back();
+			flags.pop_back();
+			versions.pop_back();
+			owners.pop_back();
+
+			orderDirty = true;
+		}
+
+		void TransformStore::update()
+		{
+			if (orderDirty)
+				rebuildOrder();
+
+			size_t const count = owners.size();
+			if (count < parallelThreshold)
+			{
+				updateRange(0, count);
+				return;
+			}
+
+			//Root subtrees are independent and contiguous, so every job updates a run of whole subtrees.
+			//The amount of roots per job is based on the average subtree size, aiming for parallelChunkSize transforms per job
+			size_t const roots = rootRanges.size();
+			size_t const rootsPerChunk = std::max<size_t>(1, parallelChunkSize * roots / count);
+			JobSystem::parallelFor(roots, rootsPerChunk, [](size_t begin, size_t end)
+			{
+				updateRange(rootRanges[begin].first, rootRanges[end - 1].second);
+			});
+		}
+
+		void TransformStore::rebuildOrder()
+		{
+			size_t const count = owners.size();
+
+			//Depth first traversal starting at every root, parents end up in front of their children
+			std::vector<uint32_t> from;
+			from.reserve(count);
+			std::vector<Transform*> stack;
+			rootRanges.clear();
+
+			for (size_t i = 0; i < count; i++)
+			{
+				if (owners[i]->parent != nullptr)
+					continue;
+
+				size_t const begin = from.size();
+				stack.push_back(owners[i]);
+				while (!stack.empty())
+				{
+					Transform* t = stack.back();
+					stack.pop_back();
+					from.push_back(t->index);
+
+					//Push in reverse so the first child is visited first
+					for (auto it = t->children.rbegin(); it != t->children.rend(); ++it)
+						stack.push_back(*it);
+				}
+				rootRanges.push_back({ begin, from.size() });
+			}
+
+			permute(localPositions, from);
+			permute(localScales, from);
+			permute(localRotations, from);
+			permute(localMatrices, from);
+			permute(worldMatrices, from);
+			permute(inverseWorldMatrices, from);
+			permute(globalScales, from);
+			permute(globalRotations, from);
+			permute(flags, from);
+			permute(versions, from);
+			permute(owners, from);
+
+			//Update the handles first, parent indices depend on them
+			for (size_t i = 0; i < count; i++)
+				owners[i]->index = (uint32_t)i;
+			for (size_t i = 0; i < count; i++)
+			{
+				Transform* parent = owners[i]->parent;
+				parents[i] = parent != nullptr ? (int32_t)parent->index : -1;
+			}
+
+			orderDirty = false;
+		}
+
+		void TransformStore::updateRange(size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				if (!(flags[i] & TF_WORLD_DIRTY))
+					continue;
+
+				//Parents are stored in front of their children, so the parent's world matrix is always up to date here
+				glm::mat4 const& local = getLocalMatrix((uint32_t)i);
+				int32_t const parent = parents[i];
+				worldMatrices[i] = parent < 0 ? local : local * worldMatrices[parent];
+				flags[i] &= ~TF_WORLD_DIRTY;
+			}
+		}
+
+		const glm::mat4& TransformStore::getLocalMatrix(uint32_t index)
+		{
+			if (flags[index] & TF_LOCAL_DIRTY)
+			{
+				glm::mat4 const t = glm::translate(glm::mat4(1.0f), localPositions[index]);
+				glm::mat4 const r = glm::mat4(localRotations[index]);
+				glm::mat4 const s = glm::scale(glm::mat4(1.0f), localScales[index]);
+				localMatrices[index] = t * r * s;
+				flags[index] &= ~TF_LOCAL_DIRTY;
+			}
+			return localMatrices[index];
+		}
+	}
+}
@@ -0,0 +1,126 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace Tristeon
+{
+	namespace Core
+	{
+		class Transform;
+		class Engine;
+
+		/**
+		 * Describes which cached values of a transform entry are outdated
+		 */
+		enum TransformFlag : uint8_t
+		{
+			TF_LOCAL_DIRTY = 1 << 0,
+			TF_WORLD_DIRTY = 1 << 1,
+			TF_INVERSE_DIRTY = 1 << 2,
+			TF_GLOBAL_DIRTY = 1 << 3,
+
+			TF_ALL_DIRTY = TF_LOCAL_DIRTY | TF_WORLD_DIRTY | TF_INVERSE_DIRTY | TF_GLOBAL_DIRTY
+		};
+
+		/**
+		 * TransformStore owns the data of every Transform in contiguous arrays (structure of arrays).
+		 * Transform itself is a thin handle that only stores its index into these arrays.
+		 *
+		 * The arrays are kept in depth-first order, which means that a parent is always stored before its children
+		 * and that every root subtree occupies a contiguous range. This allows update() to recalculate
+		 * all dirty world matrices in a single linear pass, and to split independent root subtrees across threads.
+		 *
+		 * This class is not intended to be accessed or used by users.
+		 */
+		class TransformStore final
+		{
+			friend Transform;
+			friend Engine;
+		public:
+			/**
+			 * Returns the amount of transforms currently stored
+			 */
+			static size_t size() { return owners.size(); }
+
+		private:
+			/**
+			 * Creates a new entry for the given transform and returns its index
+			 */
+			static uint32_t create(Transform* owner);
+			/**
+			 * Removes the entry at the given index. The last entry is moved into the freed slot.
+			 */
+			static void destroy(uint32_t index);
+
+			/**
+			 * Notifies the store that the hierarchy has changed. The depth-first order gets rebuilt in the next update().
+			 */
+			static void setHierarchyChanged() { orderDirty = true; }
+
+			/**
+			 * Recalculates all dirty world matrices in one pass over the depth-first arrays.
+			 * Gets called by the engine once per frame, before MT_RENDER.
+			 */
+			static void update();
+
+			/**
+			 * Sorts all arrays into depth-first order, and rebuilds the parent indices and root ranges.
+			 */
+			static void rebuildOrder();
+			/**
+			 * Updates the world matrices of the entries in [begin, end). The range must only contain complete root subtrees.
+			 */
+			static void updateRange(size_t begin, size_t end);
+			/**
+			 * Rebuilds T * R * S for the given entry if it's outdated
+			 */
+			static const glm::mat4& getLocalMatrix(uint32_t index);
+
+			//Local values
+			static std::vector<glm::vec3> localPositions;
+			static std::vector<glm::vec3> localScales;
+			static std::vector<glm::quat> localRotations;
+
+			//Cached values
+			static std::vector<glm::mat4> localMatrices;
+			static std::vector<glm::mat4> worldMatrices;
+			static std::vector<glm::mat4> inverseWorldMatrices;
+			static std::vector<glm::vec3> globalScales;
+			static std::vector<glm::quat> globalRotations;
+
+			/**
+			 * The index of the parent of each entry, -1 for roots. Only valid while the order isn't dirty.
+			 */
+			static std::vector<int32_t> parents;
+			/**
+			 * A combination of TransformFlag values for each entry
+			 */
+			static std::vector<uint8_t> flags;
+			/**
+			 * Incremented whenever the world matrix of an entry gets marked as outdated, see Transform::getVersion()
+			 */
+			static std::vector<uint32_t> versions;
+			/**
+			 * The transform handle of each entry, used to update the handles when entries are moved.
+			 */
+			static std::vector<Transform*> owners;
+
+			/**
+			 * The [begin, end) ranges of every root subtree in the arrays
+			 */
+			static std::vector<std::pair<size_t, size_t>> rootRanges;
+			static bool orderDirty;
+
+			/**
+			 * Below this amount of transforms, the update pass runs on the calling thread only
+			 */
+			static const size_t parallelThreshold = 4096;
+			/**
+			 * The amount of transforms that a single job of the parallel update pass aims for
+			 */
+			static const size_t parallelChunkSize = 1024;
+		};
+	}
+}
@@ -1,4 +1,5 @@
 ﻿#include "UserPrefs.h"
+#include "Misc/Console.h"
 
 namespace Tristeon
 {
@@ -49,7 +50,7 @@ namespace Tristeon
 			return fUserPrefs.find(pName) != fUserPrefs.end();
 		}
 
-		void UserPrefs::readPrefs()
+		void UserPrefs::readPrefs(int argc, char** argv)
 		{
 			//TODO: Load settings from settings file here
 			sUserPrefs["RENDERAPI"] = "VULKAN";
@@ -58,6 +59,36 @@ namespace Tristeon
 			bUserPrefs["FULLSCREEN"] = false;
 			iUserPrefs["SCREENWIDTH"] = 1920;
 			iUserPrefs["SCREENHEIGHT"] = 980;
+			//The amount of frames to run before the engine closes, 0 runs until the window is closed
+			iUserPrefs["FRAMES"] = 0;
+
+			//Command line overrides, the type is taken from the default value. Unknown names are stored as strings
+			for (int i = 1; i < argc; i++)
+			{
+				std::string argument = argv[i];
+				argument.erase(0, argument.find_first_not_of('-'));
+				size_t const separator = argument.find('=');
+				if (separator == std::string::npos || separator == 0)
+					continue;
+
+				std::string const name = argument.substr(0, separator);
+				std::string const value = argument.substr(separator + 1);
+				try
+				{
+					if (hasInt(name))
+						iUserPrefs[name] = std::stoi(value);
+					else if (hasFloat(name))
+						fUserPrefs[name] = std::stof(value);
+					else if (hasBool(name))
+						bUserPrefs[name] = value == "true" || value == "1";
+					else
+						sUserPrefs[name] = value;
+				}
+				catch (const std::exception&)
+				{
+					Misc::Console::warning("Ignoring invalid value " + value + " for setting " + name);
+				}
+			}
 		}
 	}
 }
\ No newline at end of file
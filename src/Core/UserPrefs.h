@@ -47,7 +47,11 @@ namespace Tristeon
 			 */
 			static bool hasFloat(const std::string& pName);
 		private:
-			static void readPrefs();
+			/**
+			 * Loads the default settings, then applies the settings given on the command line.
+			 * Command line settings have the form NAME=value, optionally preceded by - or --. E.g. --RENDERAPI=NULL --FRAMES=500
+			 */
+			static void readPrefs(int argc = 0, char** argv = nullptr);
 			static std::map<std::string, int> iUserPrefs;
 			static std::map<std::string, std::string> sUserPrefs;
 			static std::map<std::string, bool> bUserPrefs;
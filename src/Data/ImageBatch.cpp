@@ -1,4 +1,6 @@
 ﻿#include "ImageBatch.h"
+#include "Misc/Profiler.h"
+#include "Misc/MemoryTracker.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -13,6 +15,14 @@ namespace Tristeon
 		//Static
 		std::map<std::string, Image> ImageBatch::cachedImages;
 
+		/**
+		 * The size of the pixels of a loaded image, images are always loaded with 4 channels
+		 */
+		static int64_t pixelBytes(const Image& image)
+		{
+			return (int64_t)image.getWidth() * image.getHeight() * STBI_rgb_alpha;
+		}
+
 		Image ImageBatch::getImage(std::string path)
 		{
 			//Try to return a cached image
@@ -29,9 +39,13 @@ namespace Tristeon
 
 		bool ImageBatch::load(std::string path)
 		{
+			TRISTEON_PROFILE_SCOPE("ImageBatch::load");
 			//Clear old cached image
 			if (cachedImages.find(path) != cachedImages.end())
+			{
+				Misc::MemoryTracker::track(Misc::MEM_IMAGEBATCH, -pixelBytes(cachedImages[path]));
 				stbi_image_free(cachedImages[path].pixels);
+			}
 
 			//Load image
 			Image img;
@@ -41,7 +55,8 @@ namespace Tristeon
 
 			if (img.pixels && img.width != 0 && img.height != 0)
 			{
-				//Store if loading was succesful
+				//Store if loading was succesful, stb allocates the pixels so they're reported to the tracker
+				Misc::MemoryTracker::track(Misc::MEM_IMAGEBATCH, pixelBytes(img));
 				cachedImages[path] = img;
 				return true;
 			}
@@ -55,6 +70,7 @@ namespace Tristeon
 				return;
 
 			//Free, and remove
+			Misc::MemoryTracker::track(Misc::MEM_IMAGEBATCH, -pixelBytes(cachedImages[path]));
 			stbi_image_free(cachedImages[path].pixels);
 			cachedImages.erase(path);
 		}
@@ -64,6 +80,7 @@ namespace Tristeon
 			//Unload all
 			for (const auto p : cachedImages)
 			{
+				Misc::MemoryTracker::track(Misc::MEM_IMAGEBATCH, -pixelBytes(p.second));
 				stbi_image_free(p.second.pixels);
 			}
 		}
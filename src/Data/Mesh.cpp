@@ -9,6 +9,7 @@
 #include <assimp/postprocess.h>
 
 #include "Misc/Console.h"
+#include "Misc/Profiler.h"
 #include "Core/UserPrefs.h"
 
 namespace Tristeon
@@ -24,6 +25,7 @@ namespace Tristeon
 
 		void Mesh::load(std::string filePath)
 		{
+			TRISTEON_PROFILE_SCOPE("Mesh::load");
 			Assimp::Importer imp;
 
 			//Postprocessing
@@ -36,7 +38,7 @@ namespace Tristeon
 				aiProcess_GenSmoothNormals;
 
 			const std::string api = Core::UserPrefs::getStringValue("RENDERAPI");
-			if (api == "VULKAN") //Vulkan uses flipped UVs
+			if (api == "VULKAN" || api == "NULL") //Vulkan uses flipped UVs, the null backend loads meshes the same way
 				postProcess |= aiProcess_FlipUVs;
 
 			const auto scene = imp.ReadFile(filePath, postProcess);
@@ -62,6 +64,7 @@ namespace Tristeon
 						vertex.normal = glm::vec3(normal.x, normal.y, normal.z);
 						vertex.texCoord = glm::vec2(float(texCoord.x), float(texCoord.y));
 						submesh.vertices.push_back(vertex);
+						submesh.bounds.encapsulate(vertex.pos);
 					}
 
 					for (size_t j = 0; j < currentMesh->mNumFaces; j++)
@@ -4,6 +4,8 @@
 #include <glm/detail/type_vec2.hpp>
 #include "Math/Vector3.h"
 #include "Math/Vector2.h"
+#include "Math/AABB.h"
+#include "Misc/MemoryTracker.h"
 
 namespace Tristeon {
 	namespace Math {
@@ -48,23 +50,27 @@ namespace Tristeon
 		struct SubMesh
 		{
 			/**
-			 * The vertices of this mesh
+			 * The vertices of this mesh. Mesh data is tracked by the MeshBatch heap, including the copies held by MeshRenderers
 			 */
-			std::vector<Vertex> vertices;
+			Misc::TaggedVector<Vertex, Misc::MEM_MESHBATCH> vertices;
 			/**
 			 * The indices of this mesh
 			 */
-			std::vector<uint16_t> indices;
+			Misc::TaggedVector<uint16_t, Misc::MEM_MESHBATCH> indices;
 			/**
 			 * The material ID. Temporary
 			 */
 			int materialID = 0;
+			/**
+			 * The local space bounds of the vertices, calculated when the mesh is loaded
+			 */
+			Math::AABB bounds;
 		};
 
 		/**
 		 * Class for mesh handling
 		 */
-		struct Mesh : Core::TObject
+		struct Mesh : Core::TObject, Misc::Tracked<Misc::MEM_MESHBATCH>
 		{
 			/**
 			 * The list of submeshes that this mesh exists of
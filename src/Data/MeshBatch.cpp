@@ -1,4 +1,5 @@
 ﻿#include "MeshBatch.h"
+#include "Misc/Profiler.h"
 #include <valarray>
 
 namespace Tristeon
@@ -25,11 +26,19 @@ namespace Tristeon
 
 		Mesh* MeshBatch::loadMesh(std::string meshPath)
 		{
+			TRISTEON_PROFILE_SCOPE("MeshBatch::loadMesh");
 			//Loads in the mesh at the given filepath
 			std::unique_ptr<Mesh> m = std::make_unique<Mesh>();
 			m->load(meshPath);
+			Mesh* result = m.get();
 			loadedMeshes[meshPath] = move(m);
-			return m.get();
+			return result;
+		}
+
+		void MeshBatch::addMesh(const std::string& meshPath, std::unique_ptr<Mesh> mesh)
+		{
+			if (loadedMeshes.find(meshPath) == loadedMeshes.end())
+				loadedMeshes[meshPath] = move(mesh);
 		}
 
 		void MeshBatch::unloadMesh(std::string meshPath)
@@ -38,6 +38,11 @@ namespace Tristeon
 		private:
 			static std::map<std::string, std::unique_ptr<Mesh>> loadedMeshes;
 			static void unloadAll();
+
+			/**
+			 * Stores a mesh that has been loaded elsewhere, e.g. on a worker thread. Does nothing if a mesh with the same path is loaded already.
+			 */
+			static void addMesh(const std::string& meshPath, std::unique_ptr<Mesh> mesh);
 		};
 	}
 }
@@ -3,6 +3,7 @@
 #include "SceneFileItem.h"
 #include "Scenes/Scene.h"
 #include "Scenes/SceneManager.h"
+#include "Scenes/BinaryScene.h"
 #include "XPlatform/typename.h"
 
 using namespace Tristeon::Editor;
@@ -17,6 +18,8 @@ SceneFileItem::SceneFileItem()
 void SceneFileItem::createFile(nlohmann::json json)
 {
 	AssetItem::createFile(json);
+	//Keep the binary version up to date, the scene manager loads it instead of the json file
+	Scenes::BinaryScene::write(json, Scenes::BinaryScene::getBinaryPath(getFilePath()));
 	Scenes::SceneManager::addScenePath(name,getFilePath());
 }
 
@@ -8,12 +8,11 @@ using namespace Tristeon::Editor;
 void EditorNodeTree::load(nlohmann::json nodeTree)
 {
 	nodes.clear();
+	nodeIndex.clear();
 	if (nodeTree.is_array())
 	{
 		for (auto iterator = nodeTree.begin(); iterator != nodeTree.end(); ++iterator)
 		{
-			//TODO: implement a faster implementation for loading scenes, this could be very performant intensive in big scenes.
-			// Which is in reference to looking up gameObject by instanceID
 			Scenes::Scene* scene = Scenes::SceneManager::getActiveScene();
 			std::string instanceID = iterator->get<nlohmann::json>()["instanceID"];
 			Core::GameObject* foundGameObject = scene->getGameObject(instanceID);
@@ -42,30 +41,44 @@ nlohmann::json EditorNodeTree::getData()
 	return output;
 }
 
-EditorNode* EditorNodeTree::findNodeByInstanceID(std::string nodeInstanceID)
+EditorNode* EditorNodeTree::findNodeByInstanceID(uint64_t nodeInstanceID)
 {
-	for (int i = 0; i < nodes.size(); ++i)
+	auto it = nodeIndex.find(nodeInstanceID);
+	if (it == nodeIndex.end())
 	{
-		//When correct instanceID is found
-		if (nodes[i]->connectedGameObject->transform.get()->getInstanceID() == nodeInstanceID)
-			return nodes[i].get();
+		indexNodes();
+		it = nodeIndex.find(nodeInstanceID);
 	}
-	throw std::runtime_error("InstanceID couldn't be found");
+
+	if (it == nodeIndex.end())
+		throw std::runtime_error("InstanceID couldn't be found");
+	return it->second;
+}
+
+void EditorNodeTree::indexNodes()
+{
+	nodeIndex.clear();
+	nodeIndex.reserve(nodes.size());
+	for (int i = 0; i < nodes.size(); ++i)
+		nodeIndex[nodes[i]->connectedGameObject->transform.get()->getID()] = nodes[i].get();
 }
 
 void EditorNodeTree::createParentalBonds()
 {
+	indexNodes();
 	for (int i = 0; i < nodes.size(); ++i)
 	{
 		const auto parent = nodes[i]->connectedGameObject->transform.get()->getParent();
 		if (parent == nullptr) continue;
-		const std::string nodeInstanceID = parent->getInstanceID();
+		const uint64_t nodeInstanceID = parent->getID();
 		nodes[i]->move(findNodeByInstanceID(nodeInstanceID));
 	}
 }
 
 void EditorNodeTree::removeNode(EditorNode* node)
 {
+	nodeIndex.erase(node->connectedGameObject->transform.get()->getID());
+
 	//Remove gameObject
 	Scenes::SceneManager::getActiveScene()->removeGameObject(node->connectedGameObject);
 
@@ -2,6 +2,7 @@
 #ifdef TRISTEON_EDITOR
 
 #include <vector>
+#include <unordered_map>
 #include "EditorNode.h"
 
 namespace Tristeon
@@ -16,9 +17,23 @@ namespace Tristeon
 			std::vector<std::unique_ptr<EditorNode>> nodes;
 			void load(nlohmann::json nodeTree);
 			nlohmann::json getData();
-			EditorNode* findNodeByInstanceID(std::string nodeInstanceID);
+			/**
+			 * Returns the node of the gameobject whose transform has the given instanceID, in constant time
+			 * \exception runtime_error If no node is found
+			 */
+			EditorNode* findNodeByInstanceID(uint64_t nodeInstanceID);
 			void createParentalBonds();
 			void removeNode(EditorNode* node);
+		private:
+			/**
+			 * Rebuilds nodeIndex from nodes
+			 */
+			void indexNodes();
+			/**
+			 * Maps the instanceID of the transform of each node's gameobject to the node.
+			 * Nodes can be added to nodes directly, so the index is rebuilt when a lookup misses.
+			 */
+			std::unordered_map<uint64_t, EditorNode*> nodeIndex;
 		};
 	}
 }
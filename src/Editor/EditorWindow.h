@@ -2,6 +2,7 @@
 #ifdef TRISTEON_EDITOR
 
 #include <ImGUI/imgui.h>
+#include "Misc/MemoryTracker.h"
 
 namespace Tristeon
 {
@@ -13,7 +14,7 @@ namespace Tristeon
 		 * \brief EditorWindow is an interface to inherit from to create your own window, using imgui calls and overriding the ongui
 		 * function which currently is called every frame. EditorWindows currently have to be manually registered to the Editor
 		 */
-		class EditorWindow
+		class EditorWindow : public Misc::Tracked<Misc::MEM_EDITOR>
 		{
 			friend TristeonEditor;
 		public:
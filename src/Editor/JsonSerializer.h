@@ -17,6 +17,13 @@ public:
 	 */
 	template <typename T> static T* deserialize(const std::string& path);
 
+	/**
+	 * \brief Deserializes the file at the given path into obj while it's being parsed.
+	 * Every element of a top level array is passed to obj.deserializeElement() as soon as it has been parsed, consumed elements are discarded right away.
+	 * The remainder of the document is passed to obj.deserialize() afterwards. Returns false if the file couldn't be read.
+	 */
+	static bool stream(const std::string& path, Serializable& obj);
+
 	static nlohmann::json load(const std::string& path);
 };
 
@@ -64,6 +71,44 @@ inline nlohmann::json JsonSerializer::load(const std::string& path)
 }
 
 
+inline bool JsonSerializer::stream(const std::string& path, Serializable& obj)
+{
+	std::ifstream stream(path);
+	if (!stream.good()) {
+		std::cout << "Serializer can't serialize cus can't read file: " << path << "\n";
+		return false;
+	}
+
+	//Depth 1 is the top level object, depth 2 the elements of its arrays (or the members of its objects)
+	std::string key;
+	bool inArray = false;
+	nlohmann::json input = nlohmann::json::parse(stream, [&](int depth, nlohmann::json::parse_event_t event, nlohmann::json& parsed)
+	{
+		using event_t = nlohmann::json::parse_event_t;
+		if (depth == 1)
+		{
+			if (event == event_t::key)
+				key = parsed.get<std::string>();
+			else if (event == event_t::array_start || event == event_t::array_end)
+				inArray = event == event_t::array_start;
+			return true;
+		}
+
+		if (depth == 2 && inArray && (event == event_t::object_end || event == event_t::array_end || event == event_t::value))
+			return !obj.deserializeElement(key, parsed);
+		return true;
+	});
+
+	if (input.is_null())
+	{
+		std::cout << "file is either a non-json file or corrupted" << std::endl;
+		throw std::invalid_argument("file is either a non-json file or corrupted");
+	}
+
+	obj.deserialize(std::move(input));
+	return true;
+}
+
 template <typename T>
 T* JsonSerializer::deserialize(const std::string& path)
 {
@@ -88,7 +133,7 @@ T* JsonSerializer::deserialize(const std::string& path)
 	Serializable* deserializedObject = static_cast<Serializable*>(instance.get());
 	instance.release();
 	//Load json data into the instance
-	deserializedObject->deserialize(input);
+	deserializedObject->deserialize(std::move(input));
 	//Cast into the desired type
 	T* obj = static_cast<T*>(deserializedObject);
 	return obj;
@@ -14,8 +14,14 @@ public:
 	virtual nlohmann::json serialize() { return nlohmann::json(); }
 	/**
 	 * \brief Deserialize interface for classes to decide how to use json data to load in data into their class
+	 * Pass temporaries or std::move the json data in where possible, so that the data isn't deep copied.
 	 */
 	virtual void deserialize(nlohmann::json json) {}
+	/**
+	 * \brief Streaming deserialize interface, called by JsonSerializer::stream() for every element of a top level array as soon as the element has been parsed.
+	 * Return true if the element has been consumed. Consumed elements are discarded right away and won't be part of the json that is passed to deserialize() afterwards.
+	 */
+	virtual bool deserializeElement(const std::string& arrayKey, nlohmann::json& element) { return false; }
 
 	/**
 	 * \brief Checks if the T is the exact same type as this one. (Does not work with inheritance yet)
@@ -190,7 +190,7 @@ namespace Tristeon
 	{
 		//Subscribe to render callback
 		Core::MessageBus::subscribeToMessage(Core::MT_PRERENDER, std::bind(&TristeonEditor::onGui, this));
-		Core::MessageBus::subscribeToMessage(Core::MT_SHARE_DATA, [&](Core::Message msg)
+		Core::MessageBus::subscribeToMessage(Core::MT_SHARE_DATA, [&](const Core::Message& msg)
 		{
 			Core::Rendering::Vulkan::EditorData* data = dynamic_cast<Core::Rendering::Vulkan::EditorData*>(msg.userData);
 			if (data != nullptr)
@@ -1,10 +1,22 @@
-#pragma once
+﻿#pragma once
 #include "IntrospectionInterface.h"
 #include "Serializable.h"
 #include "Misc/Console.h"
 #include "XPlatform/typename.h"
+#include <new>
 
 template <typename T> std::unique_ptr<IntrospectionInterface> CreateInstance() { return std::make_unique<T>(); }
+template <typename T> Serializable* ConstructInstanceAt(void* memory) { return new (memory) T(); }
+
+/**
+ * \brief Gets instantiated for every registered type when it registers itself.
+ * Systems that need to know more about a registered type than its name can specialize this for the types they're interested in.
+ */
+template <typename T, typename Enable = void>
+struct TypeRegisterHook
+{
+	static void onRegister() { }
+};
 
 /**
  * \brief The typeregister pretty much is a map that is used to create instances of registered types
@@ -15,6 +27,18 @@ struct TypeRegister
 	//Map that contains typename as key and createinstance methods as value
 	using TypeMap = std::map<std::string, std::unique_ptr<IntrospectionInterface>(*)()>;
 
+	/**
+	 * \brief Describes the memory requirements of a registered type, and how to construct it in preallocated memory.
+	 * Used by allocators (e.g. component pools) that manage their own storage.
+	 */
+	struct TypeInfo
+	{
+		size_t size;
+		size_t alignment;
+		Serializable* (*constructAt)(void* memory);
+	};
+	using TypeInfoMap = std::map<std::string, TypeInfo>;
+
 	/**
 	 * \brief Creates instance of an object that inherits from the introspectioninterface.
 	 * The user must take ownership of the instance himself.
@@ -30,11 +54,28 @@ struct TypeRegister
 		return it->second();
 	}
 
+	/**
+	 * \brief Returns the size, alignment and in-place constructor of the given type. Nullptr if the type isn't registered.
+	 */
+	static const TypeInfo* getTypeInfo(const std::string& s)
+	{
+		const auto it = getInfoMap()->find(s);
+		if (it == getInfoMap()->end())
+			return nullptr;
+		return &it->second;
+	}
+
 	static TypeMap* getMap()
 	{
 		static TypeMap instance;
 		return &instance;
 	}
+
+	static TypeInfoMap* getInfoMap()
+	{
+		static TypeInfoMap instance;
+		return &instance;
+	}
 };
 
 
@@ -47,6 +88,8 @@ struct DerivedRegister : TypeRegister
 	DerivedRegister()
 	{
 		getMap()->emplace(TRISTEON_TYPENAME(T), &CreateInstance<T>);
+		getInfoMap()->emplace(TRISTEON_TYPENAME(T), TypeInfo{ sizeof(T), alignof(T), &ConstructInstanceAt<T> });
+		TypeRegisterHook<T>::onRegister();
 	}
 };
 
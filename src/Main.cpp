@@ -56,6 +56,7 @@
 #include "Core/Engine.h"
 #include "Core/Message.h"
 #include "Core/MessageBus.h"
+#include "Core/UserPrefs.h"
 
 #ifdef TRISTEON_EDITOR
 #include "Editor/TristeonEditor.h"
@@ -69,16 +70,30 @@ int main(int argc, char** argv)
 	FreeConsole();
 #endif
 
-	Core::Engine engine{};
+	Core::Engine engine(argc, argv);
 
+	bool startGame = true;
 #ifdef TRISTEON_EDITOR
-	Editor::TristeonEditor editor(&engine);
-#else
-	//Auto start game with the starting scene loaded in in game/release mode
-	Scenes::SceneManager::loadScene(0);
-	Core::MessageBus::sendMessage(Core::MessageType::MT_GAME_LOGIC_START);
+	//The editor needs a window, headless engines always run the game
+	std::unique_ptr<Editor::TristeonEditor> editor;
+	if (!engine.isHeadless())
+	{
+		editor = std::make_unique<Editor::TristeonEditor>(&engine);
+		startGame = false;
+	}
 #endif
 
+	if (startGame)
+	{
+		//Auto start game with the starting scene loaded in in game/release mode. The SCENE setting overrides the starting scene
+		const std::string scene = Core::UserPrefs::getStringValue("SCENE");
+		if (scene.empty())
+			Scenes::SceneManager::loadScene(0);
+		else
+			Scenes::SceneManager::loadScene(scene);
+		Core::MessageBus::sendMessage(Core::MessageType::MT_GAME_LOGIC_START);
+	}
+
 	engine.run();
 	return 0;
 }
\ No newline at end of file
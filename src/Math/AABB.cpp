@@ -0,0 +1,73 @@
+﻿#include "AABB.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Tristeon
+{
+	namespace Math
+	{
+		AABB::AABB() :
+			min(std::numeric_limits<float>::max()),
+			max(std::numeric_limits<float>::lowest())
+		{
+			//Empty
+		}
+
+		AABB::AABB(const glm::vec3& min, const glm::vec3& max) : min(min), max(max)
+		{
+			//Empty
+		}
+
+		float AABB::getPerimeter() const
+		{
+			glm::vec3 const size = max - min;
+			return size.x * size.y + size.y * size.z + size.z * size.x;
+		}
+
+		void AABB::encapsulate(const glm::vec3& point)
+		{
+			min = glm::vec3(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z));
+			max = glm::vec3(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z));
+		}
+
+		void AABB::encapsulate(const AABB& box)
+		{
+			encapsulate(box.min);
+			encapsulate(box.max);
+		}
+
+		bool AABB::contains(const AABB& box) const
+		{
+			return min.x <= box.min.x && min.y <= box.min.y && min.z <= box.min.z &&
+				max.x >= box.max.x && max.y >= box.max.y && max.z >= box.max.z;
+		}
+
+		AABB AABB::transformed(const glm::mat4& matrix) const
+		{
+			if (!isValid())
+				return AABB();
+
+			//Transform the center, and project the extents onto the absolute axes of the matrix (Arvo)
+			glm::vec3 const center = getCenter();
+			glm::vec3 const extents = getExtents();
+			glm::vec3 const newCenter = glm::vec3(matrix * glm::vec4(center, 1.0f));
+			glm::vec3 newExtents;
+			for (int row = 0; row < 3; row++)
+			{
+				newExtents[row] =
+					std::abs(matrix[0][row]) * extents.x +
+					std::abs(matrix[1][row]) * extents.y +
+					std::abs(matrix[2][row]) * extents.z;
+			}
+			return AABB(newCenter - newExtents, newCenter + newExtents);
+		}
+
+		AABB AABB::merge(const AABB& a, const AABB& b)
+		{
+			AABB result = a;
+			result.encapsulate(b);
+			return result;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+﻿#pragma once
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace Tristeon
+{
+	namespace Math
+	{
+		/**
+		 * An axis aligned bounding box, described by its minimum and maximum corner.
+		 * A default constructed AABB is empty (min > max), and becomes valid once a point or another box is added to it.
+		 */
+		struct AABB
+		{
+			/**
+			 * Creates an empty AABB
+			 */
+			AABB();
+			/**
+			 * Creates an AABB with the given corners
+			 */
+			AABB(const glm::vec3& min, const glm::vec3& max);
+
+			glm::vec3 min;
+			glm::vec3 max;
+
+			/**
+			 * Returns false if the AABB is empty
+			 */
+			bool isValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+			glm::vec3 getCenter() const { return (min + max) * 0.5f; }
+			glm::vec3 getExtents() const { return (max - min) * 0.5f; }
+
+			/**
+			 * Half of the surface area of the box. Used as the cost metric by bounding volume hierarchies.
+			 */
+			float getPerimeter() const;
+
+			/**
+			 * Grows the AABB so that it contains the given point
+			 */
+			void encapsulate(const glm::vec3& point);
+			/**
+			 * Grows the AABB so that it contains the given box
+			 */
+			void encapsulate(const AABB& box);
+
+			/**
+			 * Returns true if the given box lies completely within this box
+			 */
+			bool contains(const AABB& box) const;
+
+			/**
+			 * Returns the smallest AABB that contains this box after being transformed by the given matrix
+			 */
+			AABB transformed(const glm::mat4& matrix) const;
+
+			/**
+			 * Returns the smallest AABB that contains both boxes
+			 */
+			static AABB merge(const AABB& a, const AABB& b);
+		};
+	}
+}
@@ -0,0 +1,211 @@
+﻿#include "Frustum.h"
+#include <glm/geometric.hpp>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRISTEON_FRUSTUM_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRISTEON_FRUSTUM_SSE
+#endif
+
+namespace Tristeon
+{
+	namespace Math
+	{
+		void AABBArray::add(const AABB& box)
+		{
+			glm::vec3 const center = box.getCenter();
+			glm::vec3 const extents = box.getExtents();
+			centerX.push_back(center.x);
+			centerY.push_back(center.y);
+			centerZ.push_back(center.z);
+			extentX.push_back(extents.x);
+			extentY.push_back(extents.y);
+			extentZ.push_back(extents.z);
+		}
+
+		void AABBArray::clear()
+		{
+			centerX.clear();
+			centerY.clear();
+			centerZ.clear();
+			extentX.clear();
+			extentY.clear();
+			extentZ.clear();
+		}
+
+		void AABBArray::reserve(size_t count)
+		{
+			centerX.reserve(count);
+			centerY.reserve(count);
+			centerZ.reserve(count);
+			extentX.reserve(count);
+			extentY.reserve(count);
+			extentZ.reserve(count);
+		}
+
+		Frustum::Frustum()
+		{
+			for (glm::vec4& plane : planes)
+				plane = glm::vec4(0, 0, 0, 1);
+		}
+
+		Frustum::Frustum(const glm::mat4& view, const glm::mat4& projection)
+		{
+			//Gribb/Hartmann plane extraction, the rows of the combined matrix describe the clip space planes
+			glm::mat4 const m = projection * view;
+			glm::vec4 const row0 = glm::vec4(m[0][0], m[1][0], m[2][0], m[3][0]);
+			glm::vec4 const row1 = glm::vec4(m[0][1], m[1][1], m[2][1], m[3][1]);
+			glm::vec4 const row2 = glm::vec4(m[0][2], m[1][2], m[2][2], m[3][2]);
+			glm::vec4 const row3 = glm::vec4(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+			planes[0] = row3 + row0;
+			planes[1] = row3 - row0;
+			planes[2] = row3 + row1;
+			planes[3] = row3 - row1;
+			//-w <= z, which is the near plane in GL clip space and slightly behind it in Vulkan clip space
+			planes[4] = row3 + row2;
+			planes[5] = row3 - row2;
+
+			for (glm::vec4& plane : planes)
+			{
+				float const length = glm::length(glm::vec3(plane));
+				if (length > 0)
+					plane /= length;
+			}
+		}
+
+		FrustumTest Frustum::test(const AABB& box) const
+		{
+			if (!box.isValid())
+				return FT_OUTSIDE;
+
+			glm::vec3 const center = box.getCenter();
+			glm::vec3 const extents = box.getExtents();
+
+			FrustumTest result = FT_INSIDE;
+			for (const glm::vec4& plane : planes)
+			{
+				//Signed distance of the center, and the projected radius of the box onto the plane normal
+				float const distance = plane.x * center.x + plane.y * center.y + (plane.z * center.z + plane.w);
+				float const radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+
+				if (distance + radius < 0)
+					return FT_OUTSIDE;
+				if (distance - radius < 0)
+					result = FT_INTERSECTING;
+			}
+			return result;
+		}
+
+		size_t Frustum::intersects(const AABBArray& boxes, uint8_t* results) const
+		{
+			size_t const count = boxes.size();
+			const float* cx = boxes.centerX.data();
+			const float* cy = boxes.centerY.data();
+			const float* cz = boxes.centerZ.data();
+			const float* ex = boxes.extentX.data();
+			const float* ey = boxes.extentY.data();
+			const float* ez = boxes.extentZ.data();
+
+			size_t visible = 0;
+			size_t i = 0;
+
+#if defined(TRISTEON_FRUSTUM_AVX) || defined(TRISTEON_FRUSTUM_SSE)
+#ifdef TRISTEON_FRUSTUM_AVX
+			typedef __m256 Lane;
+			size_t const width = 8;
+			#define LANE_SET(x) _mm256_set1_ps(x)
+			#define LANE_LOAD(p) _mm256_loadu_ps(p)
+			#define LANE_ADD(a, b) _mm256_add_ps(a, b)
+			#define LANE_MUL(a, b) _mm256_mul_ps(a, b)
+			#define LANE_OR(a, b) _mm256_or_ps(a, b)
+			#define LANE_LESS(a, b) _mm256_cmp_ps(a, b, _CMP_LT_OQ)
+			#define LANE_MASK(a) _mm256_movemask_ps(a)
+			#define LANE_ZERO() _mm256_setzero_ps()
+#else
+			typedef __m128 Lane;
+			size_t const width = 4;
+			#define LANE_SET(x) _mm_set1_ps(x)
+			#define LANE_LOAD(p) _mm_loadu_ps(p)
+			#define LANE_ADD(a, b) _mm_add_ps(a, b)
+			#define LANE_MUL(a, b) _mm_mul_ps(a, b)
+			#define LANE_OR(a, b) _mm_or_ps(a, b)
+			#define LANE_LESS(a, b) _mm_cmplt_ps(a, b)
+			#define LANE_MASK(a) _mm_movemask_ps(a)
+			#define LANE_ZERO() _mm_setzero_ps()
+#endif
+			//Broadcast the planes and their absolute normals once
+			Lane px[6], py[6], pz[6], pw[6], ax[6], ay[6], az[6];
+			for (int p = 0; p < 6; p++)
+			{
+				px[p] = LANE_SET(planes[p].x);
+				py[p] = LANE_SET(planes[p].y);
+				pz[p] = LANE_SET(planes[p].z);
+				pw[p] = LANE_SET(planes[p].w);
+				ax[p] = LANE_SET(std::abs(planes[p].x));
+				ay[p] = LANE_SET(std::abs(planes[p].y));
+				az[p] = LANE_SET(std::abs(planes[p].z));
+			}
+
+			Lane const zero = LANE_ZERO();
+			for (; i + width <= count; i += width)
+			{
+				Lane const x = LANE_LOAD(cx + i);
+				Lane const y = LANE_LOAD(cy + i);
+				Lane const z = LANE_LOAD(cz + i);
+				Lane const sx = LANE_LOAD(ex + i);
+				Lane const sy = LANE_LOAD(ey + i);
+				Lane const sz = LANE_LOAD(ez + i);
+
+				//A box is outside if it's completely behind any of the planes
+				Lane outside = zero;
+				for (int p = 0; p < 6; p++)
+				{
+					Lane const distance = LANE_ADD(LANE_ADD(LANE_MUL(px[p], x), LANE_MUL(py[p], y)), LANE_ADD(LANE_MUL(pz[p], z), pw[p]));
+					Lane const radius = LANE_ADD(LANE_ADD(LANE_MUL(ax[p], sx), LANE_MUL(ay[p], sy)), LANE_MUL(az[p], sz));
+					outside = LANE_OR(outside, LANE_LESS(LANE_ADD(distance, radius), zero));
+				}
+
+				int const mask = LANE_MASK(outside);
+				for (size_t lane = 0; lane < width; lane++)
+				{
+					uint8_t const inside = (mask >> lane) & 1 ? 0 : 1;
+					results[i + lane] = inside;
+					visible += inside;
+				}
+			}
+
+			#undef LANE_SET
+			#undef LANE_LOAD
+			#undef LANE_ADD
+			#undef LANE_MUL
+			#undef LANE_OR
+			#undef LANE_LESS
+			#undef LANE_MASK
+			#undef LANE_ZERO
+#endif
+
+			//Scalar fallback, and the boxes that don't fill a whole register
+			for (; i < count; i++)
+			{
+				uint8_t inside = 1;
+				for (const glm::vec4& plane : planes)
+				{
+					float const distance = plane.x * cx[i] + plane.y * cy[i] + (plane.z * cz[i] + plane.w);
+					float const radius = std::abs(plane.x) * ex[i] + std::abs(plane.y) * ey[i] + std::abs(plane.z) * ez[i];
+					if (distance + radius < 0)
+					{
+						inside = 0;
+						break;
+					}
+				}
+				results[i] = inside;
+				visible += inside;
+			}
+			return visible;
+		}
+	}
+}
@@ -0,0 +1,78 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+#include "AABB.h"
+
+namespace Tristeon
+{
+	namespace Math
+	{
+		/**
+		 * The result of testing a volume against a frustum
+		 */
+		enum FrustumTest
+		{
+			FT_OUTSIDE,
+			FT_INTERSECTING,
+			FT_INSIDE
+		};
+
+		/**
+		 * A list of AABBs, stored as one array per component (structure of arrays) so that they can be tested against a frustum in bulk.
+		 * The boxes are stored as center and extents, which is the form that the frustum test works with.
+		 */
+		struct AABBArray
+		{
+			std::vector<float> centerX, centerY, centerZ;
+			std::vector<float> extentX, extentY, extentZ;
+
+			/**
+			 * Adds the box to the end of the arrays
+			 */
+			void add(const AABB& box);
+			void clear();
+			void reserve(size_t count);
+			size_t size() const { return centerX.size(); }
+		};
+
+		/**
+		 * A view frustum, described by six planes that point inwards.
+		 */
+		struct Frustum
+		{
+			/**
+			 * Creates a frustum that contains everything
+			 */
+			Frustum();
+			/**
+			 * Extracts the frustum planes from the given view and projection matrix
+			 */
+			Frustum(const glm::mat4& view, const glm::mat4& projection);
+
+			/**
+			 * The left, right, bottom, top, near and far planes, as (normal, distance)
+			 */
+			glm::vec4 planes[6];
+
+			/**
+			 * Returns true if the box is (partially) inside of the frustum. Conservative, a box near a corner may pass while it's outside.
+			 */
+			bool intersects(const AABB& box) const { return test(box) != FT_OUTSIDE; }
+			/**
+			 * Returns whether the box is outside, partially inside or completely inside of the frustum
+			 */
+			FrustumTest test(const AABB& box) const;
+
+			/**
+			 * Tests every box in the array against the frustum, 4 (SSE) or 8 (AVX) boxes at a time when available.
+			 * Gives the same results as intersects() for every box.
+			 * \param boxes The boxes to test
+			 * \param results Receives 1 for every box that is (partially) inside, 0 for every box that is outside. Must hold boxes.size() elements.
+			 * \return The amount of boxes that are (partially) inside
+			 */
+			size_t intersects(const AABBArray& boxes, uint8_t* results) const;
+		};
+	}
+}
@@ -0,0 +1,52 @@
+﻿#include "AllocationCounter.h"
+
+#ifdef TRISTEON_COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<uint64_t> allocations { 0 };
+
+	void* countedAllocate(size_t size)
+	{
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		void* p = std::malloc(size == 0 ? 1 : size);
+		if (p == nullptr)
+			throw std::bad_alloc();
+		return p;
+	}
+}
+
+void* operator new(size_t size) { return countedAllocate(size); }
+void* operator new[](size_t size) { return countedAllocate(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+#endif
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		uint64_t AllocationCounter::getAllocations()
+		{
+#ifdef TRISTEON_COUNT_ALLOCATIONS
+			return allocations.load(std::memory_order_relaxed);
+#else
+			return 0;
+#endif
+		}
+
+		bool AllocationCounter::isEnabled()
+		{
+#ifdef TRISTEON_COUNT_ALLOCATIONS
+			return true;
+#else
+			return false;
+#endif
+		}
+	}
+}
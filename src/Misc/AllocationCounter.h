@@ -0,0 +1,26 @@
+﻿#pragma once
+#include <cstdint>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		/**
+		 * AllocationCounter counts the heap allocations made through operator new, on all threads.
+		 * Counting replaces the global operator new and delete, so it is only compiled in when TRISTEON_COUNT_ALLOCATIONS is defined.
+		 * Without it, getAllocations() always returns 0.
+		 */
+		class AllocationCounter final
+		{
+		public:
+			/**
+			 * The total amount of allocations since the program started
+			 */
+			static uint64_t getAllocations();
+			/**
+			 * True if allocations are being counted
+			 */
+			static bool isEnabled();
+		};
+	}
+}
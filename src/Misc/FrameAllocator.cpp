@@ -0,0 +1,66 @@
+﻿#include "FrameAllocator.h"
+
+#include <algorithm>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		FrameArena FrameAllocator::arenas[2] = { { initialCapacity }, { initialCapacity } };
+		size_t FrameAllocator::current = 0;
+
+		FrameArena::FrameArena(size_t capacity)
+		{
+			addBlock(capacity);
+		}
+
+		void* FrameArena::allocate(size_t size, size_t alignment)
+		{
+			Block* block = &blocks.back();
+			size_t padding = (alignment - (reinterpret_cast<uintptr_t>(block->memory.get()) + block->offset) % alignment) % alignment;
+			if (block->offset + padding + size > block->size)
+			{
+				//Overflow blocks are at least as big as the first block, so that a frame only overflows a few times
+				addBlock(std::max(size + alignment, blocks.front().size));
+				block = &blocks.back();
+				padding = (alignment - reinterpret_cast<uintptr_t>(block->memory.get()) % alignment) % alignment;
+			}
+
+			void* result = block->memory.get() + block->offset + padding;
+			block->offset += padding + size;
+			used += padding + size;
+			return result;
+		}
+
+		void FrameArena::reset()
+		{
+			highWater = std::max(highWater, used);
+			used = 0;
+
+			if (blocks.size() > 1)
+			{
+				//Replace the blocks with one that fits the whole frame with some headroom, the next frame of this size won't have to allocate
+				blocks.clear();
+				addBlock(highWater + highWater / 4);
+			}
+			else
+				blocks.front().offset = 0;
+		}
+
+		void FrameArena::addBlock(size_t size)
+		{
+			Block block;
+			block.memory = std::unique_ptr<uint8_t[]>(new uint8_t[size]);
+			block.size = size;
+			block.offset = 0;
+			blocks.push_back(std::move(block));
+			blockAllocations++;
+		}
+
+		void FrameAllocator::nextFrame()
+		{
+			current = 1 - current;
+			arenas[current].reset();
+		}
+	}
+}
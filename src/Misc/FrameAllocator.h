@@ -0,0 +1,130 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		/**
+		 * FrameArena is a linear (bump) allocator. Allocations are a pointer increment, and are all released at once by reset().
+		 * If the arena runs out of space it allocates an overflow block. The next reset replaces all blocks with a single block
+		 * that fits everything that has been allocated, so an arena stops allocating heap memory once it has seen its largest frame.
+		 */
+		class FrameArena final
+		{
+		public:
+			FrameArena(size_t capacity);
+
+			FrameArena(const FrameArena&) = delete;
+			FrameArena& operator=(const FrameArena&) = delete;
+
+			/**
+			 * Returns size bytes of uninitialized memory, aligned to alignment (a power of two). Valid until reset() is called
+			 */
+			void* allocate(size_t size, size_t alignment);
+			/**
+			 * Releases all allocations. Destructors aren't called, the arena is meant for trivially destructible data and STL containers that don't outlive it
+			 */
+			void reset();
+
+			/**
+			 * The amount of bytes that have been allocated since the last reset, including alignment padding
+			 */
+			size_t getUsed() const { return used; }
+			/**
+			 * The amount of bytes that the arena can hold without allocating an overflow block
+			 */
+			size_t getCapacity() const { return blocks.empty() ? 0 : blocks.front().size; }
+			/**
+			 * The amount of heap allocations that the arena has made for its blocks
+			 */
+			uint64_t getBlockAllocations() const { return blockAllocations; }
+		private:
+			struct Block
+			{
+				std::unique_ptr<uint8_t[]> memory;
+				size_t size;
+				size_t offset;
+			};
+
+			void addBlock(size_t size);
+
+			std::vector<Block> blocks;
+			size_t used = 0;
+			/**
+			 * The largest amount of bytes that has been used since the last reset, the size of the block that is created by reset()
+			 */
+			size_t highWater = 0;
+			uint64_t blockAllocations = 0;
+		};
+
+		/**
+		 * FrameAllocator owns two FrameArenas and swaps them every frame, at MT_AFTERFRAME.
+		 * Memory that is allocated in a frame stays valid until the end of the next frame, so transient data can be handed to work that
+		 * completes a frame later. Only the main thread may allocate from it.
+		 */
+		class FrameAllocator final
+		{
+		public:
+			/**
+			 * Returns size bytes from the arena of the current frame
+			 */
+			static void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) { return arenas[current].allocate(size, alignment); }
+			/**
+			 * Allocates an array of count uninitialized T's from the arena of the current frame
+			 */
+			template <typename T>
+			static T* allocate(size_t count) { return static_cast<T*>(allocate(sizeof(T) * count, alignof(T))); }
+
+			/**
+			 * Swaps the arenas and resets the one that becomes the current arena, releasing what was allocated two frames ago
+			 */
+			static void nextFrame();
+
+			/**
+			 * The arena of the current frame
+			 */
+			static const FrameArena& getCurrentArena() { return arenas[current]; }
+
+			/**
+			 * The capacity that each arena starts with
+			 */
+			static const size_t initialCapacity = 1 << 20;
+		private:
+			static FrameArena arenas[2];
+			static size_t current;
+		};
+
+		/**
+		 * FrameSTLAllocator is an STL allocator that allocates from the FrameAllocator. Deallocation is a no-op,
+		 * so containers using it must not live past the next frame. Reserving up front avoids wasting arena space on growth.
+		 */
+		template <typename T>
+		class FrameSTLAllocator
+		{
+		public:
+			typedef T value_type;
+
+			FrameSTLAllocator() = default;
+			template <typename U>
+			FrameSTLAllocator(const FrameSTLAllocator<U>&) { }
+
+			T* allocate(size_t count) { return FrameAllocator::allocate<T>(count); }
+			void deallocate(T*, size_t) { }
+
+			template <typename U>
+			bool operator==(const FrameSTLAllocator<U>&) const { return true; }
+			template <typename U>
+			bool operator!=(const FrameSTLAllocator<U>&) const { return false; }
+		};
+
+		/**
+		 * A std::vector that lives in frame memory, for per frame scratch lists
+		 */
+		template <typename T>
+		using FrameVector = std::vector<T, FrameSTLAllocator<T>>;
+	}
+}
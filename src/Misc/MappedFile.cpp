@@ -0,0 +1,113 @@
+﻿#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		MappedFile::~MappedFile()
+		{
+			close();
+		}
+
+#ifdef _WIN32
+		bool MappedFile::open(const std::string& path)
+		{
+			close();
+
+			file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				file = nullptr;
+				return false;
+			}
+
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+			{
+				close();
+				return false;
+			}
+			length = (size_t)fileSize.QuadPart;
+
+			mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mappingHandle == nullptr)
+			{
+				close();
+				return false;
+			}
+
+			mapping = (const uint8_t*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+			if (mapping == nullptr)
+			{
+				close();
+				return false;
+			}
+			return true;
+		}
+
+		void MappedFile::close()
+		{
+			if (mapping != nullptr)
+				UnmapViewOfFile(mapping);
+			if (mappingHandle != nullptr)
+				CloseHandle(mappingHandle);
+			if (file != nullptr)
+				CloseHandle(file);
+
+			mapping = nullptr;
+			mappingHandle = nullptr;
+			file = nullptr;
+			length = 0;
+		}
+#else
+		bool MappedFile::open(const std::string& path)
+		{
+			close();
+
+			descriptor = ::open(path.c_str(), O_RDONLY);
+			if (descriptor < 0)
+				return false;
+
+			struct stat info;
+			if (fstat(descriptor, &info) != 0 || info.st_size == 0)
+			{
+				close();
+				return false;
+			}
+			length = (size_t)info.st_size;
+
+			void* result = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if (result == MAP_FAILED)
+			{
+				close();
+				return false;
+			}
+			mapping = (const uint8_t*)result;
+			return true;
+		}
+
+		void MappedFile::close()
+		{
+			if (mapping != nullptr)
+				munmap((void*)mapping, length);
+			if (descriptor >= 0)
+				::close(descriptor);
+
+			mapping = nullptr;
+			descriptor = -1;
+			length = 0;
+		}
+#endif
+	}
+}
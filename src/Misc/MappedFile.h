@@ -0,0 +1,49 @@
+﻿#pragma once
+#include <string>
+#include <cstdint>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		/**
+		 * MappedFile maps a file into memory as read-only. The contents are paged in by the OS on access, the file is never copied.
+		 * The mapping is released when the MappedFile is closed or destroyed, any pointers into it are invalid after that.
+		 */
+		class MappedFile final
+		{
+		public:
+			MappedFile() = default;
+			~MappedFile();
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			/**
+			 * Maps the file at the given path. Returns false if the file doesn't exist, is empty or couldn't be mapped.
+			 */
+			bool open(const std::string& path);
+			/**
+			 * Unmaps the file
+			 */
+			void close();
+
+			/**
+			 * The start of the mapped contents, nullptr if no file is mapped
+			 */
+			const uint8_t* data() const { return mapping; }
+			/**
+			 * The size of the mapped contents in bytes
+			 */
+			size_t size() const { return length; }
+		private:
+			const uint8_t* mapping = nullptr;
+			size_t length = 0;
+#ifdef _WIN32
+			void* file = nullptr;
+			void* mappingHandle = nullptr;
+#else
+			int descriptor = -1;
+#endif
+		};
+	}
+}
@@ -0,0 +1,148 @@
+﻿#include "MemoryTracker.h"
+#include "Misc/Console.h"
+#include "Editor/json.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <new>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		MemoryTracker::Heap MemoryTracker::heaps[MEM_COUNT];
+		std::vector<std::vector<int64_t>> MemoryTracker::samples;
+
+		/**
+		 * Guards samples, the heaps themselves are atomic
+		 */
+		static std::mutex samplesMutex;
+
+		void* MemoryTracker::allocate(MemoryTag tag, size_t size)
+		{
+			void* memory = std::malloc(size == 0 ? 1 : size);
+			if (memory == nullptr)
+				throw std::bad_alloc();
+
+			heaps[tag].allocations.fetch_add(1, std::memory_order_relaxed);
+			change(tag, (int64_t)size);
+			return memory;
+		}
+
+		void MemoryTracker::deallocate(MemoryTag tag, void* memory, size_t size)
+		{
+			if (memory == nullptr)
+				return;
+
+			std::free(memory);
+			heaps[tag].deallocations.fetch_add(1, std::memory_order_relaxed);
+			change(tag, -(int64_t)size);
+		}
+
+		void MemoryTracker::track(MemoryTag tag, int64_t bytes)
+		{
+			if (bytes > 0)
+				heaps[tag].allocations.fetch_add(1, std::memory_order_relaxed);
+			else if (bytes < 0)
+				heaps[tag].deallocations.fetch_add(1, std::memory_order_relaxed);
+			change(tag, bytes);
+		}
+
+		void MemoryTracker::change(MemoryTag tag, int64_t bytes)
+		{
+			Heap& heap = heaps[tag];
+			int64_t const live = heap.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+			//Raise the peak if we're the first to pass it
+			int64_t peak = heap.peakBytes.load(std::memory_order_relaxed);
+			while (live > peak && !heap.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) { }
+
+			int64_t const budget = heap.budget.load(std::memory_order_relaxed);
+			if (budget <= 0)
+				return;
+
+			if (live > budget)
+			{
+				if (!heap.overBudget.exchange(true, std::memory_order_relaxed))
+					Console::warning(std::string("The ") + getName(tag) + " heap is over its budget: " + std::to_string(live) + " of " + std::to_string(budget) + " bytes in use");
+			}
+			else if (heap.overBudget.load(std::memory_order_relaxed))
+				heap.overBudget.store(false, std::memory_order_relaxed);
+		}
+
+		void MemoryTracker::setBudget(MemoryTag tag, int64_t bytes)
+		{
+			heaps[tag].budget.store(bytes > 0 ? bytes : 0, std::memory_order_relaxed);
+			heaps[tag].overBudget.store(false, std::memory_order_relaxed);
+			//Warn right away if the heap is already over the new budget
+			change(tag, 0);
+		}
+
+		HeapStats MemoryTracker::getStats(MemoryTag tag)
+		{
+			const Heap& heap = heaps[tag];
+			HeapStats stats;
+			stats.liveBytes = heap.liveBytes.load(std::memory_order_relaxed);
+			stats.peakBytes = heap.peakBytes.load(std::memory_order_relaxed);
+			stats.allocations = heap.allocations.load(std::memory_order_relaxed);
+			stats.deallocations = heap.deallocations.load(std::memory_order_relaxed);
+			stats.budget = heap.budget.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+		const char* MemoryTracker::getName(MemoryTag tag)
+		{
+			static const char* const names[] = { "Scene", "Components", "MeshBatch", "ImageBatch", "Rendering", "Editor" };
+			static_assert(sizeof(names) / sizeof(names[0]) == MEM_COUNT, "Every MemoryTag needs a name");
+			return tag < MEM_COUNT ? names[tag] : "Unknown";
+		}
+
+		void MemoryTracker::sample()
+		{
+			std::vector<int64_t> sample(MEM_COUNT);
+			for (int i = 0; i < MEM_COUNT; i++)
+				sample[i] = heaps[i].liveBytes.load(std::memory_order_relaxed);
+
+			std::lock_guard<std::mutex> lock(samplesMutex);
+			if (samples.size() >= maxSamples)
+				samples.erase(samples.begin());
+			samples.push_back(std::move(sample));
+		}
+
+		bool MemoryTracker::dump(const std::string& filePath)
+		{
+			nlohmann::json output;
+			for (int i = 0; i < MEM_COUNT; i++)
+			{
+				MemoryTag const tag = (MemoryTag)i;
+				HeapStats const stats = getStats(tag);
+
+				nlohmann::json heap;
+				heap["liveBytes"] = stats.liveBytes;
+				heap["peakBytes"] = stats.peakBytes;
+				heap["allocations"] = stats.allocations;
+				heap["deallocations"] = stats.deallocations;
+				//Allocations that haven't been freed yet, a count that keeps growing over a session points at a leak
+				heap["liveAllocations"] = (int64_t)stats.allocations - (int64_t)stats.deallocations;
+				heap["budget"] = stats.budget;
+				heap["samples"] = nlohmann::json::array();
+				output["heaps"][getName(tag)] = heap;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(samplesMutex);
+				for (const std::vector<int64_t>& sample : samples)
+					for (int i = 0; i < MEM_COUNT; i++)
+						output["heaps"][getName((MemoryTag)i)]["samples"].push_back(sample[i]);
+			}
+			output["sampleInterval"] = 1;
+
+			std::ofstream stream(filePath);
+			if (!stream)
+				return false;
+			stream << output.dump(4);
+			return stream.good();
+		}
+	}
+}
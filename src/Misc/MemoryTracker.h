@@ -0,0 +1,164 @@
+﻿#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		/**
+		 * Describes the subsystem that owns an allocation. Every tag has its own heap in the MemoryTracker
+		 */
+		enum MemoryTag
+		{
+			MEM_SCENE,
+			MEM_COMPONENTS,
+			MEM_MESHBATCH,
+			MEM_IMAGEBATCH,
+			MEM_RENDERING,
+			MEM_EDITOR,
+
+			MEM_COUNT
+		};
+
+		/**
+		 * The statistics of a single heap
+		 */
+		struct HeapStats
+		{
+			/**
+			 * The amount of bytes that are currently allocated
+			 */
+			int64_t liveBytes = 0;
+			/**
+			 * The largest amount of bytes that has been allocated at the same time
+			 */
+			int64_t peakBytes = 0;
+			uint64_t allocations = 0;
+			uint64_t deallocations = 0;
+			/**
+			 * The budget in bytes, 0 if the heap has no budget
+			 */
+			int64_t budget = 0;
+		};
+
+		/**
+		 * MemoryTracker keeps track of the memory of every subsystem in a named heap, see MemoryTag.
+		 * Subsystems allocate through allocate() and deallocate(), by deriving from Tracked or by using TaggedAllocator in their containers.
+		 * Memory that is allocated by libraries can be reported through track().
+		 *
+		 * Heaps can be given a budget, a warning is written once a heap goes over it. All functions are thread safe.
+		 */
+		class MemoryTracker final
+		{
+		public:
+			/**
+			 * Allocates size bytes on the heap of the given tag
+			 */
+			static void* allocate(MemoryTag tag, size_t size);
+			/**
+			 * Frees memory that was allocated with allocate(), size must match the allocated size
+			 */
+			static void deallocate(MemoryTag tag, void* memory, size_t size);
+			/**
+			 * Reports memory that has been allocated (positive bytes) or freed (negative bytes) outside of the tracker
+			 */
+			static void track(MemoryTag tag, int64_t bytes);
+
+			/**
+			 * Sets the budget of a heap in bytes. 0 removes the budget
+			 */
+			static void setBudget(MemoryTag tag, int64_t bytes);
+			/**
+			 * Returns the current statistics of a heap
+			 */
+			static HeapStats getStats(MemoryTag tag);
+			/**
+			 * Returns the name of a heap, as it is shown in dumps and budget warnings
+			 */
+			static const char* getName(MemoryTag tag);
+
+			/**
+			 * Records the live bytes of every heap, so that dumps show how the heaps grow over time. Called once per second by the engine
+			 */
+			static void sample();
+			/**
+			 * Writes the statistics and the sampled history of every heap to filePath as json
+			 * \return False if the file couldn't be written
+			 */
+			static bool dump(const std::string& filePath);
+
+			/**
+			 * The amount of samples that are kept, older samples are dropped
+			 */
+			static const size_t maxSamples = 3600;
+		private:
+			struct Heap
+			{
+				std::atomic<int64_t> liveBytes { 0 };
+				std::atomic<int64_t> peakBytes { 0 };
+				std::atomic<uint64_t> allocations { 0 };
+				std::atomic<uint64_t> deallocations { 0 };
+				std::atomic<int64_t> budget { 0 };
+				/**
+				 * Set while the heap is over its budget, so that the warning is only written once every time the budget is exceeded
+				 */
+				std::atomic<bool> overBudget { false };
+			};
+
+			static void change(MemoryTag tag, int64_t bytes);
+
+			static Heap heaps[MEM_COUNT];
+			static std::vector<std::vector<int64_t>> samples;
+		};
+
+		/**
+		 * Deriving from Tracked makes new and delete of a class allocate on the heap of the given tag.
+		 * Classes that are deleted through a base pointer must have a virtual destructor, so that the size of the derived class is freed.
+		 */
+		template <MemoryTag Tag>
+		class Tracked
+		{
+		public:
+			static void* operator new(size_t size) { return MemoryTracker::allocate(Tag, size); }
+			static void operator delete(void* memory, size_t size) { MemoryTracker::deallocate(Tag, memory, size); }
+
+			//Declaring the operators above hides placement new, which is used to construct objects in memory owned by someone else
+			static void* operator new(size_t, void* memory) { return memory; }
+			static void operator delete(void*, void*) { }
+		};
+
+		/**
+		 * TaggedAllocator is an STL allocator that allocates on the heap of the given tag
+		 */
+		template <typename T, MemoryTag Tag>
+		class TaggedAllocator
+		{
+		public:
+			typedef T value_type;
+			template <typename U>
+			struct rebind { typedef TaggedAllocator<U, Tag> other; };
+
+			TaggedAllocator() = default;
+			template <typename U>
+			TaggedAllocator(const TaggedAllocator<U, Tag>&) { }
+
+			T* allocate(size_t count) { return static_cast<T*>(MemoryTracker::allocate(Tag, sizeof(T) * count)); }
+			void deallocate(T* memory, size_t count) { MemoryTracker::deallocate(Tag, memory, sizeof(T) * count); }
+
+			template <typename U>
+			bool operator==(const TaggedAllocator<U, Tag>&) const { return true; }
+			template <typename U>
+			bool operator!=(const TaggedAllocator<U, Tag>&) const { return false; }
+		};
+
+		/**
+		 * A std::vector whose elements are allocated on the heap of the given tag
+		 */
+		template <typename T, MemoryTag Tag>
+		using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+	}
+}
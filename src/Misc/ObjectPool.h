@@ -1,28 +1,179 @@
 ﻿#pragma once
-#include <queue>
-#include "vector.h"
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
- * Objectpool is a class that manages a set of initialized objects kept ready to use – a "pool" – rather than allocating and destroying them on demand. 
- * The user of the pool can request an object from the pool using get() and perform operations on the returned object. 
- * When the client has finished, they can return the object to the pool using release(), rather than destroying it. 
+ * PoolSlabs is the storage shared by ObjectPool and HandlePool. Objects live in slots inside of fixed size slabs,
+ * slabs are only freed when the storage is destroyed so objects never move. Unused slots form an intrusive free list,
+ * which makes acquiring and releasing a slot O(1).
+ * T The type of the stored objects. SlabSize The amount of slots per slab.
+ */
+template<typename T, size_t SlabSize>
+class PoolSlabs
+{
+public:
+	static_assert(SlabSize > 0, "PoolSlabs needs at least one slot per slab!");
+
+	/**
+	 * A single slot. The object is stored first, so that a pointer to the object is a pointer to its slot
+	 */
+	struct Slot
+	{
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		/**
+		 * The index of the next free slot, only valid while the slot is in the free list
+		 */
+		uint32_t next;
+		uint32_t index;
+		/**
+		 * Incremented every time the object in the slot is destroyed, used to detect stale handles
+		 */
+		uint32_t generation;
+		/**
+		 * True while the object in the slot is constructed
+		 */
+		bool constructed;
+		/**
+		 * True while the slot has been handed out
+		 */
+		bool used;
+
+		T* object() { return reinterpret_cast<T*>(&storage); }
+	};
+	PoolSlabs() = default;
+	PoolSlabs(const PoolSlabs&) = delete;
+	PoolSlabs& operator=(const PoolSlabs&) = delete;
+	~PoolSlabs() { destroyAll(); }
+
+	/**
+	 * Takes a slot from the free list, adds a slab if there are no free slots. The slot is marked as used
+	 */
+	Slot* acquire();
+	/**
+	 * Puts a slot back into the free list. The object isn't destroyed
+	 */
+	void release(Slot* slot);
+
+	/**
+	 * Returns the slot at the given index, the index has to be smaller than capacity()
+	 */
+	Slot* at(uint32_t index) const { return &slabs[index / SlabSize][index % SlabSize]; }
+	/**
+	 * Returns the slot of an object that is stored in this storage
+	 */
+	static Slot* slotOf(T* object) { return reinterpret_cast<Slot*>(object); }
+
+	/**
+	 * Destroys the object in the slot, if it is constructed
+	 */
+	static void destroy(Slot* slot);
+	/**
+	 * Destroys every constructed object. Slots that are in use are put back into the free list
+	 */
+	void destroyAll();
+
+	/**
+	 * The amount of slots in all slabs
+	 */
+	size_t capacity() const { return slabs.size() * SlabSize; }
+	/**
+	 * The amount of slots that are in use
+	 */
+	size_t size() const { return used; }
+private:
+	static const uint32_t none = UINT32_MAX;
+
+	std::vector<std::unique_ptr<Slot[]>> slabs;
+	uint32_t freeList = none;
+	size_t used = 0;
+};
+
+template <typename T, size_t SlabSize>
+typename PoolSlabs<T, SlabSize>::Slot* PoolSlabs<T, SlabSize>::acquire()
+{
+	//Checked here rather than in the class, so that pools can be declared with incomplete types
+	static_assert(std::is_standard_layout<Slot>::value, "PoolSlabs::Slot has to be standard layout to convert between objects and slots!");
+
+	if (freeList == none)
+	{
+		//Chain the new slots in order, so that they're handed out in memory order
+		uint32_t const first = (uint32_t)capacity();
+		std::unique_ptr<Slot[]> slab(new Slot[SlabSize]);
+		for (uint32_t i = 0; i < SlabSize; i++)
+		{
+			slab[i].index = first + i;
+			slab[i].next = i + 1 < SlabSize ? first + i + 1 : none;
+			slab[i].generation = 0;
+			slab[i].constructed = false;
+			slab[i].used = false;
+		}
+		slabs.push_back(std::move(slab));
+		freeList = first;
+	}
+
+	Slot* slot = at(freeList);
+	freeList = slot->next;
+	slot->used = true;
+	used++;
+	return slot;
+}
+
+template <typename T, size_t SlabSize>
+void PoolSlabs<T, SlabSize>::release(Slot* slot)
+{
+	slot->used = false;
+	slot->next = freeList;
+	freeList = slot->index;
+	used--;
+}
+
+template <typename T, size_t SlabSize>
+void PoolSlabs<T, SlabSize>::destroy(Slot* slot)
+{
+	if (!slot->constructed)
+		return;
+	slot->object()->~T();
+	slot->constructed = false;
+	slot->generation++;
+}
+
+template <typename T, size_t SlabSize>
+void PoolSlabs<T, SlabSize>::destroyAll()
+{
+	for (size_t i = 0; i < capacity(); i++)
+	{
+		Slot* slot = at((uint32_t)i);
+		destroy(slot);
+		if (slot->used)
+			release(slot);
+	}
+}
+
+/**
+ * Objectpool is a class that manages a set of initialized objects kept ready to use – a "pool" – rather than allocating and destroying them on demand.
+ * The user of the pool can request an object from the pool using get() and perform operations on the returned object.
+ * When the client has finished, they can return the object to the pool using release(), rather than destroying it.
+ * Objects are constructed in place in slabs of SlabSize objects, get() and release() are O(1) and objects never move.
  * Resource The type of resource. Has to be a pointer.
  */
-template<typename Resource>
+template<typename Resource, size_t SlabSize = 64>
 class ObjectPool
 {
 public:
 	static_assert(std::is_pointer<Resource>::value, "ObjectPool expects a pointer type!");
-
-	~ObjectPool();
+	typedef std::remove_pointer_t<Resource> Type;
 
 	/**
-	 * Returns an unused resource from the pool. Creates a new resource if no resources are available
+	 * Returns an unused resource from the pool. Constructs a new resource if no initialized resources are available
 	 */
 	Resource get();
 
 	/**
-	 * Puts the given resource back into the pool
+	 * Puts the given resource back into the pool. The resource stays initialized, and is handed out again by get()
 	 */
 	void release(Resource resource);
 	/**
@@ -33,70 +184,145 @@ public:
 	 * Deallocates all resources created by the pool. Any references to objects in the pool will turn invalid.
 	 */
 	void reset();
-private:
-	/**
-	 * The currently unused (available) pool objects.
-	 */
-	std::queue<Resource> available;
+
 	/**
-	 * A list keeping track of the actively used pool objects.
+	 * The amount of resources that are currently in use
 	 */
-	Tristeon::vector<Resource> used;
+	size_t size() const { return slabs.size(); }
+private:
+	PoolSlabs<Type, SlabSize> slabs;
 };
 
-template <typename Resource>
-ObjectPool<Resource>::~ObjectPool()
-{
-	reset();
-}
-
-template <typename Resource>
-Resource ObjectPool<Resource>::get()
+template <typename Resource, size_t SlabSize>
+Resource ObjectPool<Resource, SlabSize>::get()
 {
-	//Create a new resource if we're out of available resources
-	if (available.size() == 0)
+	//Released slots are at the front of the free list, so initialized resources are reused first
+	auto* slot = slabs.acquire();
+	if (!slot->constructed)
 	{
-		Resource r = new std::remove_pointer_t<Resource>();
-		available.push(r);
+		new (&slot->storage) Type();
+		slot->constructed = true;
 	}
-
-	//Return the first available resource
-	Resource r = available.front();
-	available.pop();
-	used.push_back(r);
-	return r;
+	return slot->object();
 }
 
-template <typename Resource>
-void ObjectPool<Resource>::release(Resource resource)
+template <typename Resource, size_t SlabSize>
+void ObjectPool<Resource, SlabSize>::release(Resource resource)
 {
 	//We don't have null resources
 	if (resource == nullptr)
 		return;
 
-	used.remove(resource);
-	available.push(resource);
+	auto* slot = PoolSlabs<Type, SlabSize>::slotOf(resource);
+	if (!slot->used)
+		return;
+	slabs.release(slot);
 }
 
-template <typename Resource>
-void ObjectPool<Resource>::clearUnused()
+template <typename Resource, size_t SlabSize>
+void ObjectPool<Resource, SlabSize>::clearUnused()
 {
-	//Clear the available objects queue
-	while (!available.empty())
+	//The slots stay in the free list, they're constructed again when they're handed out
+	for (size_t i = 0; i < slabs.capacity(); i++)
 	{
-		Resource r = available.front();
-		available.pop();
-		delete r;
+		auto* slot = slabs.at((uint32_t)i);
+		if (!slot->used)
+			PoolSlabs<Type, SlabSize>::destroy(slot);
 	}
 }
 
-template <typename Resource>
-void ObjectPool<Resource>::reset()
+template <typename Resource, size_t SlabSize>
+void ObjectPool<Resource, SlabSize>::reset()
+{
+	slabs.destroyAll();
+}
+
+/**
+ * HandlePool stores objects in slabs like ObjectPool, but hands out handles instead of pointers.
+ * A handle contains the generation of its slot, so a handle to a destroyed object is detected rather than resolving to whichever object reuses the slot.
+ * Objects are constructed by create() and destroyed by destroy(), both are O(1).
+ */
+template<typename T, size_t SlabSize = 64>
+class HandlePool
+{
+public:
+	/**
+	 * Refers to an object in the pool. Default constructed handles are never valid
+	 */
+	struct Handle
+	{
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+
+		bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+		bool operator!=(const Handle& other) const { return !(*this == other); }
+	};
+
+	/**
+	 * Constructs a new object with the given arguments and returns its handle
+	 */
+	template <typename... Args>
+	Handle create(Args&&... args);
+	/**
+	 * Destroys the object. Returns false if the handle is stale
+	 */
+	bool destroy(Handle handle);
+
+	/**
+	 * Returns the object, or nullptr if the handle is stale
+	 */
+	T* get(Handle handle) const;
+	/**
+	 * Returns true if the handle refers to a live object
+	 */
+	bool isValid(Handle handle) const { return get(handle) != nullptr; }
+
+	/**
+	 * Destroys all objects, every handle turns stale
+	 */
+	void clear() { slabs.destroyAll(); }
+	/**
+	 * The amount of live objects
+	 */
+	size_t size() const { return slabs.size(); }
+private:
+	PoolSlabs<T, SlabSize> slabs;
+};
+
+template <typename T, size_t SlabSize>
+template <typename... Args>
+typename HandlePool<T, SlabSize>::Handle HandlePool<T, SlabSize>::create(Args&&... args)
+{
+	auto* slot = slabs.acquire();
+	new (&slot->storage) T(std::forward<Args>(args)...);
+	slot->constructed = true;
+
+	Handle handle;
+	handle.index = slot->index;
+	handle.generation = slot->generation;
+	return handle;
+}
+
+template <typename T, size_t SlabSize>
+bool HandlePool<T, SlabSize>::destroy(Handle handle)
+{
+	if (!isValid(handle))
+		return false;
+
+	auto* slot = slabs.at(handle.index);
+	PoolSlabs<T, SlabSize>::destroy(slot);
+	slabs.release(slot);
+	return true;
+}
+
+template <typename T, size_t SlabSize>
+T* HandlePool<T, SlabSize>::get(Handle handle) const
 {
-	clearUnused();
+	if (handle.index >= slabs.capacity())
+		return nullptr;
 
-	//Clear all the objects currently in use
-	for (size_t i = 0; i < used.size(); i++)
-		delete used[i];
-	used.clear();
+	auto* slot = slabs.at(handle.index);
+	if (!slot->constructed || slot->generation != handle.generation)
+		return nullptr;
+	return slot->object();
 }
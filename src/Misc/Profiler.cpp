@@ -0,0 +1,98 @@
+﻿#include "Profiler.h"
+#include "Editor/json.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		std::vector<std::unique_ptr<Profiler::ThreadBuffer>> Profiler::buffers;
+		std::mutex Profiler::buffersMutex;
+		thread_local Profiler::ThreadBuffer* Profiler::threadBuffer = nullptr;
+		const std::chrono::steady_clock::time_point Profiler::startTime = std::chrono::steady_clock::now();
+
+		void Profiler::setThreadName(const std::string& name)
+		{
+			ThreadBuffer* buffer = getBuffer();
+			std::lock_guard<std::mutex> lock(buffersMutex);
+			buffer->name = name;
+		}
+
+		bool Profiler::dump(const std::string& filePath)
+		{
+			nlohmann::json events = nlohmann::json::array();
+			{
+				std::lock_guard<std::mutex> lock(buffersMutex);
+				for (const auto& buffer : buffers)
+				{
+					nlohmann::json threadName;
+					threadName["name"] = "thread_name";
+					threadName["ph"] = "M";
+					threadName["pid"] = 0;
+					threadName["tid"] = buffer->threadID;
+					threadName["args"]["name"] = buffer->name;
+					events.push_back(threadName);
+
+					//Copy the events first, the thread keeps recording while we read
+					uint64_t const head = buffer->head.load(std::memory_order_acquire);
+					uint64_t const first = head > bufferCapacity ? head - bufferCapacity : 0;
+					std::vector<ProfileEvent> copy;
+					copy.reserve((size_t)(head - first));
+					for (uint64_t i = first; i < head; i++)
+						copy.push_back(buffer->events[i & (bufferCapacity - 1)]);
+
+					//Events that have been overwritten while copying (and the one that might be written right now) are dropped
+					uint64_t const overwritten = buffer->head.load(std::memory_order_acquire) + 1;
+					uint64_t const valid = overwritten > bufferCapacity ? std::max(first, overwritten - bufferCapacity) : first;
+
+					for (uint64_t i = valid; i < head; i++)
+					{
+						const ProfileEvent& e = copy[(size_t)(i - first)];
+						nlohmann::json event;
+						event["name"] = e.name;
+						event["ph"] = "X";
+						event["pid"] = 0;
+						event["tid"] = buffer->threadID;
+						//Chrome traces are in microseconds
+						event["ts"] = e.start / 1000.0;
+						event["dur"] = (e.end - e.start) / 1000.0;
+						event["args"]["depth"] = e.depth;
+						events.push_back(event);
+					}
+				}
+			}
+
+			nlohmann::json output;
+			output["traceEvents"] = events;
+			output["displayTimeUnit"] = "ms";
+
+			std::ofstream stream(filePath);
+			if (!stream)
+				return false;
+			stream << output.dump();
+			return stream.good();
+		}
+
+		void Profiler::clear()
+		{
+			std::lock_guard<std::mutex> lock(buffersMutex);
+			for (const auto& buffer : buffers)
+				buffer->head.store(0, std::memory_order_release);
+		}
+
+		Profiler::ThreadBuffer* Profiler::createBuffer()
+		{
+			std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+			buffer->events = std::unique_ptr<ProfileEvent[]>(new ProfileEvent[bufferCapacity]);
+
+			std::lock_guard<std::mutex> lock(buffersMutex);
+			buffer->threadID = (uint32_t)buffers.size();
+			buffer->name = "Thread " + std::to_string(buffer->threadID);
+			threadBuffer = buffer.get();
+			buffers.push_back(std::move(buffer));
+			return threadBuffer;
+		}
+	}
+}
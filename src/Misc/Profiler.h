@@ -0,0 +1,152 @@
+﻿#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define TRISTEON_PROFILE_CONCAT_IMPL(a, b) a##b
+#define TRISTEON_PROFILE_CONCAT(a, b) TRISTEON_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef TRISTEON_PROFILE
+/**
+ * Records the time spent in the rest of the current scope under the given name.
+ * The name isn't copied, it has to stay valid for as long as the profiler runs (e.g. a string literal).
+ * Markers are removed entirely when TRISTEON_PROFILE isn't defined.
+ */
+#define TRISTEON_PROFILE_SCOPE(name) Tristeon::Misc::ProfileScope TRISTEON_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define TRISTEON_PROFILE_SCOPE(name)
+#endif
+
+namespace Tristeon
+{
+	namespace Misc
+	{
+		/**
+		 * A single timed scope. Times are in nanoseconds since the profiler started
+		 */
+		struct ProfileEvent
+		{
+			const char* name;
+			uint64_t start;
+			uint64_t end;
+			/**
+			 * The amount of scopes that this scope is nested in on its thread
+			 */
+			uint32_t depth;
+		};
+
+		/**
+		 * Profiler records the scopes marked with TRISTEON_PROFILE_SCOPE, and writes them to a Chrome trace file (chrome://tracing) on request.
+		 * Every thread records into its own ring buffer without locking. Once a buffer is full, the oldest events of that thread are overwritten,
+		 * so a dump always contains the most recent frames.
+		 */
+		class Profiler final
+		{
+		public:
+			/**
+			 * Gives the calling thread a name, shown in the trace
+			 */
+			static void setThreadName(const std::string& name);
+
+			/**
+			 * Writes the recorded events of all threads to filePath in the Chrome trace event format.
+			 * Can be called from any thread, threads keep recording while the events are being collected.
+			 * \return False if the file couldn't be written
+			 */
+			static bool dump(const std::string& filePath);
+			/**
+			 * Removes all recorded events. Threads must not be recording while clear is called.
+			 */
+			static void clear();
+
+			/**
+			 * Starts a scope on the calling thread and returns its start time
+			 */
+			static uint64_t begin();
+			/**
+			 * Ends the scope that was started with begin() and records it
+			 */
+			static void end(const char* name, uint64_t start);
+
+			/**
+			 * The amount of events that every thread keeps. Must be a power of two
+			 */
+			static const size_t bufferCapacity = 1 << 15;
+		private:
+			struct ThreadBuffer
+			{
+				std::unique_ptr<ProfileEvent[]> events;
+				/**
+				 * The amount of events that have been recorded, only written by the owning thread
+				 */
+				std::atomic<uint64_t> head { 0 };
+				uint32_t depth = 0;
+				uint32_t threadID = 0;
+				std::string name;
+			};
+
+			static uint64_t now();
+			/**
+			 * Returns the buffer of the calling thread, creating it if it doesn't exist yet
+			 */
+			static ThreadBuffer* getBuffer();
+			static ThreadBuffer* createBuffer();
+
+			/**
+			 * Buffers are owned by the profiler rather than their thread, so that events of finished threads can still be dumped
+			 */
+			static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+			static std::mutex buffersMutex;
+			static thread_local ThreadBuffer* threadBuffer;
+			static const std::chrono::steady_clock::time_point startTime;
+		};
+
+		/**
+		 * Records the lifetime of the object as a profiler event, created by TRISTEON_PROFILE_SCOPE
+		 */
+		class ProfileScope final
+		{
+		public:
+			explicit ProfileScope(const char* name) : name(name), start(Profiler::begin()) { }
+			~ProfileScope() { Profiler::end(name, start); }
+
+			ProfileScope(const ProfileScope&) = delete;
+			ProfileScope& operator=(const ProfileScope&) = delete;
+		private:
+			const char* name;
+			uint64_t start;
+		};
+
+		inline uint64_t Profiler::now()
+		{
+			return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+		}
+
+		inline Profiler::ThreadBuffer* Profiler::getBuffer()
+		{
+			return threadBuffer != nullptr ? threadBuffer : createBuffer();
+		}
+
+		inline uint64_t Profiler::begin()
+		{
+			getBuffer()->depth++;
+			return now();
+		}
+
+		inline void Profiler::end(const char* name, uint64_t start)
+		{
+			uint64_t const end = now();
+			ThreadBuffer* buffer = getBuffer();
+			buffer->depth--;
+
+			//Only this thread writes head, publishing it with release makes sure that a dump sees the finished event
+			uint64_t const index = buffer->head.load(std::memory_order_relaxed);
+			buffer->events[index & (bufferCapacity - 1)] = { name, start, end, buffer->depth };
+			buffer->head.store(index + 1, std::memory_order_release);
+		}
+	}
+}
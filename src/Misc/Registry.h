@@ -0,0 +1,111 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Tristeon
+{
+	/**
+	 * Registry is a dense, unordered list of pointers with O(1) add, remove and contains.
+	 * Every element stores its own index in the registry in a uint32_t member, which is passed to the constructor as a pointer to member.
+	 * Removing an element moves the last element into its place, so the order of the elements changes when elements are removed.
+	 *
+	 * An element can be in multiple registries as long as each registry uses a different index member,
+	 * registries that never contain the same element at the same time can share one.
+	 */
+	template<typename T>
+	class Registry
+	{
+	public:
+		typedef uint32_t T::*IndexMember;
+		typedef typename std::vector<T*>::const_iterator const_iterator;
+
+		/**
+		 * The index of elements that aren't in a registry
+		 */
+		static const uint32_t invalidIndex = UINT32_MAX;
+
+		explicit Registry(IndexMember index) : index(index) { }
+		Registry(const Registry&) = delete;
+		Registry& operator=(const Registry&) = delete;
+
+		/**
+		 * Adds the element at the end of the registry
+		 * \return False if the element is null or already in the registry
+		 */
+		bool add(T* element);
+		/**
+		 * Adds the elements at the end of the registry in the given order, with a single reservation.
+		 * Null elements and elements that are already in the registry are skipped.
+		 */
+		void add(T* const* elements, size_t count);
+		/**
+		 * Removes the element, the last element takes its place
+		 * \return False if the element isn't in the registry
+		 */
+		bool remove(T* element);
+		/**
+		 * Checks if the element is in this registry
+		 */
+		bool contains(const T* element) const;
+
+		/**
+		 * Removes all elements. The elements aren't accessed, so they may already have been destroyed
+		 */
+		void clear() { elements.clear(); }
+		void reserve(size_t capacity) { elements.reserve(capacity); }
+
+		size_t size() const { return elements.size(); }
+		bool empty() const { return elements.empty(); }
+		T* operator[](size_t i) const { return elements[i]; }
+		T* const* data() const { return elements.data(); }
+		const_iterator begin() const { return elements.begin(); }
+		const_iterator end() const { return elements.end(); }
+	private:
+		std::vector<T*> elements;
+		IndexMember index;
+	};
+
+	template <typename T>
+	bool Registry<T>::add(T* element)
+	{
+		if (element == nullptr || contains(element))
+			return false;
+
+		element->*index = (uint32_t)elements.size();
+		elements.push_back(element);
+		return true;
+	}
+
+	template <typename T>
+	void Registry<T>::add(T* const* elements, size_t count)
+	{
+		this->elements.reserve(this->elements.size() + count);
+		for (size_t i = 0; i < count; i++)
+			add(elements[i]);
+	}
+
+	template <typename T>
+	bool Registry<T>::remove(T* element)
+	{
+		if (element == nullptr || !contains(element))
+			return false;
+
+		uint32_t const i = element->*index;
+		T* last = elements.back();
+		elements[i] = last;
+		last->*index = i;
+		elements.pop_back();
+
+		element->*index = invalidIndex;
+		return true;
+	}
+
+	template <typename T>
+	bool Registry<T>::contains(const T* element) const
+	{
+		//The index member can be stale or belong to another registry, so the element at the index has to be checked too
+		uint32_t const i = element->*index;
+		return i < elements.size() && elements[i] == element;
+	}
+}
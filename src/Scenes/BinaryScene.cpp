@@ -0,0 +1,388 @@
+﻿#include "BinaryScene.h"
+#include "Scene.h"
+#include "Core/GameObject.h"
+#include "Core/Transform.h"
+#include "Core/Components/Camera.h"
+#include "Core/Rendering/Components/MeshRenderer.h"
+#include "Editor/JsonSerializer.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3.h"
+#include "Misc/Console.h"
+#include "Misc/MappedFile.h"
+#include "Misc/Profiler.h"
+#include "XPlatform/typename.h"
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace Tristeon
+{
+	namespace Scenes
+	{
+		using namespace BinarySceneFormat;
+
+		namespace
+		{
+			/**
+			 * Collects the string table, component table and data block while a scene is being written
+			 */
+			struct Writer
+			{
+				std::vector<StringEntry> strings;
+				std::unordered_map<std::string, uint32_t> stringIndices;
+				std::vector<GameObjectEntry> gameObjects;
+				std::vector<ComponentEntry> components;
+				std::vector<uint8_t> data;
+
+				uint32_t addString(const std::string& value)
+				{
+					const auto it = stringIndices.find(value);
+					if (it != stringIndices.end())
+						return it->second;
+
+					const uint32_t index = (uint32_t)strings.size();
+					strings.push_back({ (uint32_t)data.size(), (uint32_t)value.size() });
+					data.insert(data.end(), value.begin(), value.end());
+					stringIndices[value] = index;
+					return index;
+				}
+
+				/**
+				 * Appends the bytes of value to the data block and returns their offset
+				 */
+				template <typename T>
+				uint32_t addData(const T& value)
+				{
+					const uint32_t offset = (uint32_t)data.size();
+					const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+					data.insert(data.end(), bytes, bytes + sizeof(T));
+					return offset;
+				}
+			};
+
+			uint64_t align(uint64_t offset)
+			{
+				return (offset + 7) / 8 * 8;
+			}
+
+			std::string getString(const nlohmann::json& json, const char* key)
+			{
+				const auto it = json.find(key);
+				if (it == json.end() || !it->is_string())
+					return "";
+				return it->get<std::string>();
+			}
+
+			void getVector(const nlohmann::json& json, const char* key, float* output)
+			{
+				Math::Vector3 vector;
+				const auto it = json.find(key);
+				if (it != json.end() && it->is_object())
+					vector.deserialize(*it);
+				output[0] = vector.x;
+				output[1] = vector.y;
+				output[2] = vector.z;
+			}
+
+			bool isString(const nlohmann::json& json, const char* key)
+			{
+				const auto it = json.find(key);
+				return it != json.end() && it->is_string();
+			}
+
+			bool isNumber(const nlohmann::json& json, const char* key)
+			{
+				const auto it = json.find(key);
+				return it != json.end() && it->is_number();
+			}
+
+			bool isUnsigned(const nlohmann::json& json, const char* key)
+			{
+				const auto it = json.find(key);
+				return it != json.end() && it->is_number_unsigned();
+			}
+
+			/**
+			 * Returns true if the table of count elements of the given size at offset fits within the file
+			 */
+			bool fits(uint64_t offset, uint64_t count, uint64_t elementSize, size_t fileSize)
+			{
+				return offset <= fileSize && count <= (fileSize - offset) / elementSize;
+			}
+		}
+
+		std::string BinaryScene::getBinaryPath(const std::string& scenePath)
+		{
+			return scenePath + ".bin";
+		}
+
+		bool BinaryScene::convert(const std::string& scenePath, const std::string& binaryPath)
+		{
+			const nlohmann::json scene = JsonSerializer::load(scenePath);
+			if (scene.is_null())
+				return false;
+			return write(scene, binaryPath);
+		}
+
+		bool BinaryScene::write(const nlohmann::json& scene, const std::string& binaryPath)
+		{
+			Writer writer;
+			Header header {};
+			std::memcpy(header.magic, magic, sizeof(magic));
+			header.version = version;
+			header.name = writer.addString(getString(scene, "name"));
+
+			static const std::string meshRendererType = TRISTEON_TYPENAME(Core::Rendering::MeshRenderer);
+			static const std::string cameraType = TRISTEON_TYPENAME(Core::Components::Camera);
+
+			const auto gameObjectData = scene.find("gameObjects");
+			if (gameObjectData != scene.end() && gameObjectData->is_array())
+			{
+				writer.gameObjects.reserve(gameObjectData->size());
+				for (const nlohmann::json& gameObject : *gameObjectData)
+				{
+					GameObjectEntry entry {};
+					entry.instanceID = Core::TObject::parseInstanceID(getString(gameObject, "instanceID"));
+					const auto active = gameObject.find("active");
+					entry.active = active == gameObject.end() || !active->is_boolean() || active->get<bool>() ? 1 : 0;
+					entry.name = writer.addString(getString(gameObject, "name"));
+					entry.tag = writer.addString(getString(gameObject, "tag"));
+					entry.prefabFilePath = writer.addString(getString(gameObject, "prefabFilePath"));
+
+					const auto transform = gameObject.find("transform");
+					if (transform != gameObject.end() && transform->is_object())
+					{
+						entry.transformID = Core::TObject::parseInstanceID(getString(*transform, "instanceID"));
+						entry.parentID = Core::TObject::parseInstanceID(getString(*transform, "parentID"));
+						getVector(*transform, "localPosition", entry.localPosition);
+						getVector(*transform, "localScale", entry.localScale);
+
+						//Rotations are stored as euler angles in json, convert them once here instead of on every load
+						float euler[3];
+						getVector(*transform, "localRotation", euler);
+						const glm::quat rotation = Math::Quaternion::euler(euler[0], euler[1], euler[2]).getGLMQuat();
+						entry.localRotation[0] = rotation.x;
+						entry.localRotation[1] = rotation.y;
+						entry.localRotation[2] = rotation.z;
+						entry.localRotation[3] = rotation.w;
+					}
+
+					entry.firstComponent = (uint32_t)writer.components.size();
+					const auto components = gameObject.find("components");
+					if (components != gameObject.end() && components->is_array())
+					{
+						for (const nlohmann::json& component : *components)
+						{
+							const std::string typeID = getString(component, "typeID");
+							ComponentEntry componentEntry {};
+							componentEntry.typeID = writer.addString(typeID);
+
+							//The built-in components are stored as structs so that loading them doesn't parse anything,
+							//the data of other components differs per type and is stored as-is in CBOR form
+							if (typeID == meshRendererType && isString(component, "meshPath") && isUnsigned(component, "subMeshID") && isString(component, "materialPath"))
+							{
+								MeshRendererData meshRenderer {};
+								meshRenderer.meshPath = writer.addString(component["meshPath"].get<std::string>());
+								meshRenderer.subMeshID = component["subMeshID"].get<uint32_t>();
+								meshRenderer.materialPath = writer.addString(component["materialPath"].get<std::string>());
+								componentEntry.encoding = CE_MESHRENDERER;
+								componentEntry.dataOffset = writer.addData(meshRenderer);
+								componentEntry.dataSize = sizeof(MeshRendererData);
+							}
+							else if (typeID == cameraType && isNumber(component, "fov") && isNumber(component, "nearClippingPlane") && isNumber(component, "farClippingPlane") && isString(component, "skybox"))
+							{
+								CameraData camera {};
+								camera.fov = component["fov"].get<float>();
+								camera.nearClippingPlane = component["nearClippingPlane"].get<float>();
+								camera.farClippingPlane = component["farClippingPlane"].get<float>();
+								camera.skybox = writer.addString(component["skybox"].get<std::string>());
+								componentEntry.encoding = CE_CAMERA;
+								componentEntry.dataOffset = writer.addData(camera);
+								componentEntry.dataSize = sizeof(CameraData);
+							}
+							else
+							{
+								const std::vector<uint8_t> bytes = nlohmann::json::to_cbor(component);
+								componentEntry.encoding = CE_CBOR;
+								componentEntry.dataOffset = (uint32_t)writer.data.size();
+								componentEntry.dataSize = (uint32_t)bytes.size();
+								writer.data.insert(writer.data.end(), bytes.begin(), bytes.end());
+							}
+							writer.components.push_back(componentEntry);
+						}
+					}
+					entry.componentCount = (uint32_t)writer.components.size() - entry.firstComponent;
+					writer.gameObjects.push_back(entry);
+				}
+			}
+
+			header.stringCount = (uint32_t)writer.strings.size();
+			header.gameObjectCount = (uint32_t)writer.gameObjects.size();
+			header.componentCount = (uint32_t)writer.components.size();
+			header.stringTableOffset = sizeof(Header);
+			header.gameObjectTableOffset = align(header.stringTableOffset + writer.strings.size() * sizeof(StringEntry));
+			header.componentTableOffset = header.gameObjectTableOffset + writer.gameObjects.size() * sizeof(GameObjectEntry);
+			header.dataOffset = header.componentTableOffset + writer.components.size() * sizeof(ComponentEntry);
+			header.dataSize = writer.data.size();
+
+			std::ofstream stream(binaryPath, std::ios::binary | std::ios::trunc);
+			if (!stream.good())
+			{
+				Misc::Console::warning("Couldn't write binary scene " + binaryPath);
+				return false;
+			}
+
+			const char padding[8] = {};
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			stream.write(reinterpret_cast<const char*>(writer.strings.data()), writer.strings.size() * sizeof(StringEntry));
+			stream.write(padding, header.gameObjectTableOffset - header.stringTableOffset - writer.strings.size() * sizeof(StringEntry));
+			stream.write(reinterpret_cast<const char*>(writer.gameObjects.data()), writer.gameObjects.size() * sizeof(GameObjectEntry));
+			stream.write(reinterpret_cast<const char*>(writer.components.data()), writer.components.size() * sizeof(ComponentEntry));
+			stream.write(reinterpret_cast<const char*>(writer.data.data()), writer.data.size());
+			return stream.good();
+		}
+
+		Scene* BinaryScene::load(const std::string& binaryPath)
+		{
+			TRISTEON_PROFILE_SCOPE("BinaryScene::load");
+			Misc::MappedFile file;
+			if (!file.open(binaryPath))
+				return nullptr;
+
+			const uint8_t* bytes = file.data();
+			const size_t size = file.size();
+			if (size < sizeof(Header))
+			{
+				Misc::Console::warning("Binary scene " + binaryPath + " is corrupted");
+				return nullptr;
+			}
+
+			const Header& header = *reinterpret_cast<const Header*>(bytes);
+			if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version)
+			{
+				Misc::Console::warning("Binary scene " + binaryPath + " has an unsupported format");
+				return nullptr;
+			}
+
+			if (!fits(header.stringTableOffset, header.stringCount, sizeof(StringEntry), size) ||
+				!fits(header.gameObjectTableOffset, header.gameObjectCount, sizeof(GameObjectEntry), size) ||
+				!fits(header.componentTableOffset, header.componentCount, sizeof(ComponentEntry), size) ||
+				!fits(header.dataOffset, header.dataSize, 1, size) ||
+				header.stringTableOffset % 8 != 0 || header.gameObjectTableOffset % 8 != 0 || header.componentTableOffset % 8 != 0)
+			{
+				Misc::Console::warning("Binary scene " + binaryPath + " is corrupted");
+				return nullptr;
+			}
+
+			const StringEntry* strings = reinterpret_cast<const StringEntry*>(bytes + header.stringTableOffset);
+			const GameObjectEntry* gameObjects = reinterpret_cast<const GameObjectEntry*>(bytes + header.gameObjectTableOffset);
+			const ComponentEntry* components = reinterpret_cast<const ComponentEntry*>(bytes + header.componentTableOffset);
+			const uint8_t* data = bytes + header.dataOffset;
+
+			bool valid = true;
+			auto getString = [&](uint32_t index) -> std::string
+			{
+				if (index >= header.stringCount || !fits(strings[index].offset, strings[index].length, 1, header.dataSize))
+				{
+					valid = false;
+					return "";
+				}
+				return std::string(reinterpret_cast<const char*>(data + strings[index].offset), strings[index].length);
+			};
+
+			//The bundled json library only parses CBOR from a vector, every CBOR payload is copied into this buffer on its own
+			std::vector<uint8_t> payload;
+
+			std::unique_ptr<Scene> scene = std::make_unique<Scene>();
+			scene->name = getString(header.name);
+			scene->gameObjects.reserve(header.gameObjectCount);
+			scene->slots.reserve(header.gameObjectCount);
+			scene->instanceIndex.reserve(header.gameObjectCount);
+			scene->transformIndex.reserve(header.gameObjectCount);
+
+			for (uint32_t i = 0; i < header.gameObjectCount && valid; i++)
+			{
+				const GameObjectEntry& entry = gameObjects[i];
+				std::unique_ptr<Core::GameObject> gameObject = std::make_unique<Core::GameObject>();
+				gameObject->instanceID = entry.instanceID;
+				gameObject->active = entry.active != 0;
+				gameObject->name = getString(entry.name);
+				gameObject->tag = getString(entry.tag);
+				gameObject->prefabFilePath = getString(entry.prefabFilePath);
+
+				Core::Transform* transform = gameObject->_transform.get();
+				transform->instanceID = entry.transformID;
+				transform->parentID = entry.parentID;
+				transform->setLocalTransform(
+					{ entry.localPosition[0], entry.localPosition[1], entry.localPosition[2] },
+					{ entry.localScale[0], entry.localScale[1], entry.localScale[2] },
+					glm::quat(entry.localRotation[3], entry.localRotation[0], entry.localRotation[1], entry.localRotation[2]));
+
+				if (entry.firstComponent > header.componentCount || entry.componentCount > header.componentCount - entry.firstComponent)
+				{
+					valid = false;
+					break;
+				}
+
+				for (uint32_t c = entry.firstComponent; c < entry.firstComponent + entry.componentCount; c++)
+				{
+					const ComponentEntry& componentEntry = components[c];
+					if (!fits(componentEntry.dataOffset, componentEntry.dataSize, 1, header.dataSize))
+					{
+						valid = false;
+						break;
+					}
+
+					const uint8_t* const componentData = data + componentEntry.dataOffset;
+					if (componentEntry.encoding == CE_MESHRENDERER && componentEntry.dataSize == sizeof(MeshRendererData))
+					{
+						MeshRendererData meshRenderer;
+						std::memcpy(&meshRenderer, componentData, sizeof(MeshRendererData));
+						gameObject->addComponent<Core::Rendering::MeshRenderer>()->load(getString(meshRenderer.meshPath), meshRenderer.subMeshID, getString(meshRenderer.materialPath));
+					}
+					else if (componentEntry.encoding == CE_CAMERA && componentEntry.dataSize == sizeof(CameraData))
+					{
+						CameraData cameraData;
+						std::memcpy(&cameraData, componentData, sizeof(CameraData));
+						Core::Components::Camera* camera = gameObject->addComponent<Core::Components::Camera>();
+						camera->fov = cameraData.fov;
+						camera->nearClippingPlane = cameraData.nearClippingPlane;
+						camera->farClippingPlane = cameraData.farClippingPlane;
+						const std::string skybox = getString(cameraData.skybox);
+						if (!skybox.empty())
+							camera->setSkybox(skybox);
+					}
+					else if (componentEntry.encoding == CE_CBOR)
+					{
+						//A truncated or damaged payload makes the parser throw, which invalidates the whole file
+						try
+						{
+							payload.assign(componentData, componentData + componentEntry.dataSize);
+							gameObject->loadComponent(getString(componentEntry.typeID), nlohmann::json::from_cbor(payload), false);
+						}
+						catch (const std::exception&)
+						{
+							valid = false;
+							break;
+						}
+					}
+					else
+					{
+						valid = false;
+						break;
+					}
+				}
+
+				scene->pushGameObject(std::move(gameObject));
+			}
+
+			if (!valid)
+			{
+				Misc::Console::warning("Binary scene " + binaryPath + " is corrupted");
+				return nullptr;
+			}
+			return scene.release();
+		}
+	}
+}
@@ -0,0 +1,138 @@
+﻿#pragma once
+#include <string>
+#include <cstdint>
+#include "Editor/json.hpp"
+
+namespace Tristeon
+{
+	namespace Scenes
+	{
+		class Scene;
+
+		/**
+		 * The layout of binary scene files. All values are little endian, all offsets are in bytes from the start of the file.
+		 *
+		 * [Header][StringEntry * stringCount][GameObjectEntry * gameObjectCount][ComponentEntry * componentCount][data]
+		 *
+		 * Strings and component data live in the data block. Strings are referred to by their index in the string table.
+		 * The built-in components are stored as plain structs, all other component data is stored as CBOR.
+		 * Every table is aligned to 8 bytes so that entries can be read in place from a memory mapped file.
+		 */
+		namespace BinarySceneFormat
+		{
+			const char magic[4] = { 'T', 'S', 'C', 'N' };
+			const uint32_t version = 2;
+
+			struct Header
+			{
+				char magic[4];
+				uint32_t version;
+				uint32_t name;
+				uint32_t stringCount;
+				uint32_t gameObjectCount;
+				uint32_t componentCount;
+				uint64_t stringTableOffset;
+				uint64_t gameObjectTableOffset;
+				uint64_t componentTableOffset;
+				uint64_t dataOffset;
+				uint64_t dataSize;
+			};
+
+			struct StringEntry
+			{
+				uint32_t offset;
+				uint32_t length;
+			};
+
+			struct GameObjectEntry
+			{
+				uint64_t instanceID;
+				uint64_t transformID;
+				uint64_t parentID;
+				float localPosition[3];
+				float localScale[3];
+				/**
+				 * x, y, z, w
+				 */
+				float localRotation[4];
+				uint32_t name;
+				uint32_t tag;
+				uint32_t prefabFilePath;
+				uint32_t firstComponent;
+				uint32_t componentCount;
+				uint32_t active;
+			};
+
+			/**
+			 * How the data of a component is stored
+			 */
+			enum ComponentEncoding : uint32_t
+			{
+				CE_CBOR,
+				CE_MESHRENDERER,
+				CE_CAMERA
+			};
+
+			struct ComponentEntry
+			{
+				uint32_t typeID;
+				uint32_t encoding;
+				uint32_t dataOffset;
+				uint32_t dataSize;
+			};
+
+			/**
+			 * The data of a MeshRenderer, strings are indices in the string table
+			 */
+			struct MeshRendererData
+			{
+				uint32_t meshPath;
+				uint32_t subMeshID;
+				uint32_t materialPath;
+			};
+
+			/**
+			 * The data of a Camera, strings are indices in the string table
+			 */
+			struct CameraData
+			{
+				float fov;
+				float nearClippingPlane;
+				float farClippingPlane;
+				uint32_t skybox;
+			};
+
+			static_assert(sizeof(Header) == 64, "BinarySceneFormat::Header has an unexpected size");
+			static_assert(sizeof(GameObjectEntry) == 88, "BinarySceneFormat::GameObjectEntry has an unexpected size");
+			static_assert(sizeof(ComponentEntry) == 16, "BinarySceneFormat::ComponentEntry has an unexpected size");
+		}
+
+		/**
+		 * BinaryScene reads and writes the binary scene format, a compact alternative to the JSON .scene files.
+		 * Binary scenes are memory mapped and read in place, without building a JSON document of the whole scene.
+		 */
+		class BinaryScene final
+		{
+		public:
+			/**
+			 * Returns the path of the binary scene that belongs to the given JSON scene file
+			 */
+			static std::string getBinaryPath(const std::string& scenePath);
+
+			/**
+			 * Converts the JSON scene file at scenePath to a binary scene file at binaryPath. Returns false if either file couldn't be accessed.
+			 */
+			static bool convert(const std::string& scenePath, const std::string& binaryPath);
+			/**
+			 * Writes serialized scene data (as created by Scene::serialize()) to a binary scene file. Returns false if the file couldn't be written.
+			 */
+			static bool write(const nlohmann::json& scene, const std::string& binaryPath);
+
+			/**
+			 * Loads a binary scene file. Returns nullptr if the file doesn't exist or isn't a valid binary scene.
+			 * The components aren't initialized until the scene is.
+			 */
+			static Scene* load(const std::string& binaryPath);
+		};
+	}
+}
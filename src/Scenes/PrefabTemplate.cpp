@@ -0,0 +1,80 @@
+﻿#include "PrefabTemplate.h"
+#include "Editor/JsonSerializer.h"
+#include "Misc/Profiler.h"
+
+namespace Tristeon
+{
+	namespace Scenes
+	{
+		PrefabTemplate* PrefabTemplate::get(const std::string& filePath)
+		{
+			TRISTEON_PROFILE_SCOPE("PrefabTemplate::get");
+			PrefabTemplate* prefab = find(filePath);
+			if (prefab != nullptr)
+				return prefab;
+
+			nlohmann::json json = JsonSerializer::load(filePath);
+			if (!json.is_object())
+			{
+				Misc::Console::warning("Couldn't load prefab " + filePath);
+				return nullptr;
+			}
+
+			prefab = new PrefabTemplate();
+			prefab->filePath = filePath;
+			if (json["name"].is_string())
+			{
+				const std::string nameValue = json["name"];
+				prefab->name = nameValue;
+			}
+			if (json["tag"].is_string())
+			{
+				const std::string tagValue = json["tag"];
+				prefab->tag = tagValue;
+			}
+			if (json["active"].is_boolean())
+				prefab->active = json["active"];
+
+			nlohmann::json& transform = json["transform"];
+			Math::Vector3 position, scale(1, 1, 1), eulerAngles;
+			if (transform.is_object())
+			{
+				position.deserialize(transform["localPosition"]);
+				scale.deserialize(transform["localScale"]);
+				eulerAngles.deserialize(transform["localRotation"]);
+			}
+			prefab->localPosition = Vec_Convert3(position);
+			prefab->localScale = Vec_Convert3(scale);
+			prefab->localRotation = Math::Quaternion::euler(eulerAngles).getGLMQuat();
+
+			for (nlohmann::json& component : json["components"])
+			{
+				const std::string typeID = component["typeID"];
+				uint32_t const type = TypeRegister::getTypeInfo(typeID) != nullptr ? Core::Components::ComponentTypes::id(typeID) : Core::Components::ComponentTypes::unknownType;
+				prefab->components.push_back({ typeID, type, std::move(component) });
+			}
+
+			getTemplates()[filePath] = std::unique_ptr<PrefabTemplate>(prefab);
+			return prefab;
+		}
+
+		void PrefabTemplate::unload(const std::string& filePath)
+		{
+			getTemplates().erase(filePath);
+		}
+
+		PrefabTemplate* PrefabTemplate::find(const std::string& filePath)
+		{
+			auto& templates = getTemplates();
+			const auto it = templates.find(filePath);
+			return it != templates.end() ? it->second.get() : nullptr;
+		}
+
+		std::map<std::string, std::unique_ptr<PrefabTemplate>>& PrefabTemplate::getTemplates()
+		{
+			//Intentionally never destroyed, the pooled GameObjects can't outlive the transform store
+			static auto* templates = new std::map<std::string, std::unique_ptr<PrefabTemplate>>();
+			return *templates;
+		}
+	}
+}
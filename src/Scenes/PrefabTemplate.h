@@ -0,0 +1,88 @@
+﻿#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "Core/GameObject.h"
+#include "Math/Vector3.h"
+#include "Math/Quaternion.h"
+
+namespace Tristeon
+{
+	namespace Scenes
+	{
+		class Scene;
+
+		/**
+		 * The transform that an instance of a prefab is created with, in local space
+		 */
+		struct InstanceTransform
+		{
+			Math::Vector3 position;
+			Math::Quaternion rotation;
+			Math::Vector3 scale = { 1, 1, 1 };
+		};
+
+		/**
+		 * PrefabTemplate is a parsed prefab file that is kept in memory, so that it can be instantiated without touching the disk.
+		 * Destroyed instances of the prefab are kept by the template and reused by the next instantiation, see Scene::instantiate() and Scene::destroy().
+		 */
+		class PrefabTemplate final
+		{
+			friend Scene;
+		public:
+			/**
+			 * Returns the template of the prefab file at the given path. The file is loaded the first time, and cached after.
+			 * Returns nullptr if the file couldn't be loaded.
+			 */
+			static PrefabTemplate* get(const std::string& filePath);
+			/**
+			 * Removes the template from the cache, together with its reusable instances. Live instances aren't affected.
+			 */
+			static void unload(const std::string& filePath);
+
+			/**
+			 * The filepath of the prefab
+			 */
+			const std::string& getFilePath() const { return filePath; }
+			/**
+			 * The amount of destroyed instances that are kept for reuse
+			 */
+			size_t getPoolSize() const { return pool.size(); }
+		private:
+			PrefabTemplate() = default;
+
+			/**
+			 * Returns the cached template of the given prefab file, nullptr if it isn't loaded
+			 */
+			static PrefabTemplate* find(const std::string& filePath);
+			static std::map<std::string, std::unique_ptr<PrefabTemplate>>& getTemplates();
+
+			std::string filePath;
+			std::string name;
+			std::string tag;
+			bool active = true;
+			glm::vec3 localPosition;
+			glm::vec3 localScale;
+			glm::quat localRotation;
+
+			struct ComponentData
+			{
+				std::string typeID;
+				/**
+				 * The ComponentTypes ID of typeID, unknownType if it isn't a registered type
+				 */
+				uint32_t type;
+				nlohmann::json data;
+			};
+			std::vector<ComponentData> components;
+
+			/**
+			 * Destroyed instances with their deregistered components, ready to be reused
+			 */
+			std::vector<std::unique_ptr<Core::GameObject>> pool;
+		};
+	}
+}
@@ -1,4 +1,6 @@
 ﻿#include "Scene.h"
+#include "SceneManager.h"
+#include "Core/MessageBus.h"
 #include <iostream>
 #include "XPlatform/typename.h"
 
@@ -10,6 +12,8 @@ namespace Tristeon
 
 		void Scene::init()
 		{
+			//All the components register themselves in a single batch
+			Core::MessageBus::Batch batch;
 			for (int i = 0; i < gameObjects.size(); i++)
 				gameObjects[i]->init();
 		}
@@ -30,15 +34,17 @@ namespace Tristeon
 
 		void Scene::deserialize(nlohmann::json json)
 		{
-			nlohmann::json gameObjectData = json["gameObjects"];
+			nlohmann::json& gameObjectData = json["gameObjects"];
 			if (gameObjectData.is_array())
 			{
-				for (auto iterator = gameObjectData.begin(); iterator != gameObjectData.end(); ++iterator)
-				{
-					std::unique_ptr<Core::GameObject> gameObject = std::make_unique<Core::GameObject>();
-					gameObject->deserialize(iterator->get<nlohmann::json>());
-					gameObjects.push_back(std::move(gameObject));
-				}
+				size_t const count = gameObjectData.size();
+				gameObjects.reserve(gameObjects.size() + count);
+				slots.reserve(slots.size() + count);
+				instanceIndex.reserve(instanceIndex.size() + count);
+				transformIndex.reserve(transformIndex.size() + count);
+
+				for (nlohmann::json& gameObject : gameObjectData)
+					loadGameObject(std::move(gameObject));
 			} else
 			{
 				std::cout << "Deserialization of the scene is going goofy, ur probably deserializing the scene with a wrong json format";
@@ -47,28 +53,247 @@ namespace Tristeon
 			name = nameValue;
 		}
 
-		void Scene::addGameObject(std::unique_ptr<Core::GameObject> gameObj)
+		bool Scene::deserializeElement(const std::string& arrayKey, nlohmann::json& element)
+		{
+			if (arrayKey != "gameObjects")
+				return false;
+			loadGameObject(std::move(element), false);
+			return true;
+		}
+
+		void Scene::loadGameObject(nlohmann::json data, bool initComponents)
+		{
+			std::unique_ptr<Core::GameObject> gameObject = std::make_unique<Core::GameObject>();
+			gameObject->deserialize(std::move(data), initComponents);
+			pushGameObject(std::move(gameObject));
+		}
+
+		void Scene::pushGameObject(std::unique_ptr<Core::GameObject> gameObj)
 		{
-			gameObj->deserialize(gameObj->serialize());
+			addToIndex(gameObj.get());
+			slots[gameObj->sceneSlot].position = (uint32_t)gameObjects.size();
 			gameObjects.push_back(std::move(gameObj));
 		}
 
+		void Scene::addGameObject(std::unique_ptr<Core::GameObject> gameObj)
+		{
+			//The components of a GameObject that is added to the running scene are registered right away, the others when the scene is loaded
+			if (SceneManager::getActiveScene() == this)
+				gameObj->init();
+			pushGameObject(std::move(gameObj));
+		}
+
 		void Scene::removeGameObject(Core::GameObject* gameObj)
 		{
-			for (int i = 0; i < gameObjects.size(); ++i)
+			if (gameObj == nullptr || gameObj->sceneSlot >= slots.size() || slots[gameObj->sceneSlot].gameObject != gameObj)
+				return;
+
+			uint32_t const position = slots[gameObj->sceneSlot].position;
+			removeFromIndex(gameObj);
+			if (position != gameObjects.size() - 1)
+			{
+				gameObjects[position] = std::move(gameObjects.back());
+				slots[gameObjects[position]->sceneSlot].position = position;
+			}
+			gameObjects.pop_back();
+		}
+
+		std::vector<Core::GameObject*> Scene::instantiate(PrefabTemplate* prefab, size_t count, const InstanceTransform* transforms)
+		{
+			std::vector<Core::GameObject*> instances;
+			if (prefab == nullptr)
+				return instances;
+
+			instances.reserve(count);
+			gameObjects.reserve(gameObjects.size() + count);
+			instanceIndex.reserve(instanceIndex.size() + count);
+			transformIndex.reserve(transformIndex.size() + count);
+
+			//The components of all the instances register themselves in a single batch
+			Core::MessageBus::Batch batch;
+			for (size_t i = 0; i < count; i++)
+			{
+				std::unique_ptr<Core::GameObject> gameObject;
+				if (!prefab->pool.empty())
+				{
+					gameObject = std::move(prefab->pool.back());
+					prefab->pool.pop_back();
+				}
+				else
+					gameObject = std::make_unique<Core::GameObject>();
+
+				gameObject->name = prefab->name;
+				gameObject->tag = prefab->tag;
+				gameObject->active = prefab->active;
+				gameObject->prefabFilePath = prefab->filePath;
+				gameObject->pooled = false;
+
+				if (transforms != nullptr)
+					gameObject->_transform->setLocalTransform(Vec_Convert3(transforms[i].position), Vec_Convert3(transforms[i].scale), transforms[i].rotation.getGLMQuat());
+				else
+					gameObject->_transform->setLocalTransform(prefab->localPosition, prefab->localScale, prefab->localRotation);
+
+				//Reused instances still have the components of the template, which are deserialized in place instead of being recreated.
+				//Instances whose components were changed while they were alive get a new set.
+				bool reuse = gameObject->components.size() == prefab->components.size();
+				for (size_t c = 0; reuse && c < prefab->components.size(); c++)
+					reuse = gameObject->getComponentType(c) == prefab->components[c].type;
+
+				if (reuse)
+				{
+					for (size_t c = 0; c < prefab->components.size(); c++)
+					{
+						Core::Components::Component* component = gameObject->components[c].get();
+						component->init();
+						component->deserialize(prefab->components[c].data);
+					}
+				}
+				else
+				{
+					gameObject->clearComponents();
+					for (const PrefabTemplate::ComponentData& component : prefab->components)
+						gameObject->loadComponent(component.typeID, component.data);
+				}
+
+				instances.push_back(gameObject.get());
+				pushGameObject(std::move(gameObject));
+			}
+			return instances;
+		}
+
+		Core::GameObject* Scene::instantiate(PrefabTemplate* prefab, const InstanceTransform* transform)
+		{
+			std::vector<Core::GameObject*> const instances = instantiate(prefab, 1, transform);
+			return instances.empty() ? nullptr : instances[0];
+		}
+
+		void Scene::destroy(Core::GameObject* gameObj)
+		{
+			if (gameObj == nullptr || gameObj->destroyed)
+				return;
+			gameObj->destroyed = true;
+			destroyedCount++;
+		}
+
+		void Scene::flushDestroyed()
+		{
+			if (destroyedCount == 0)
+				return;
+			destroyedCount = 0;
+
+			size_t kept = 0;
+			for (size_t i = 0; i < gameObjects.size(); i++)
 			{
-				if (gameObjects[i].get() == gameObj) { gameObjects.erase(gameObjects.begin() + i); }
+				if (!gameObjects[i]->destroyed)
+				{
+					if (kept != i)
+					{
+						gameObjects[kept] = std::move(gameObjects[i]);
+						slots[gameObjects[kept]->sceneSlot].position = (uint32_t)kept;
+					}
+					kept++;
+					continue;
+				}
+
+				std::unique_ptr<Core::GameObject> gameObject = std::move(gameObjects[i]);
+				removeFromIndex(gameObject.get());
+
+				//Keep instances of loaded prefabs around to be reused, everything else is destroyed right here
+				PrefabTemplate* prefab = gameObject->prefabFilePath.empty() ? nullptr : PrefabTemplate::find(gameObject->prefabFilePath);
+				if (prefab != nullptr)
+				{
+					gameObject->_transform->detach();
+					gameObject->recycle();
+					prefab->pool.push_back(std::move(gameObject));
+				}
 			}
+			gameObjects.resize(kept);
 		}
 
 		Core::GameObject* Scene::getGameObject(std::string instanceID)
 		{
-			for (int i = 0; i < gameObjects.size(); ++i)
+			return getGameObject(Core::TObject::parseInstanceID(instanceID));
+		}
+
+		Core::GameObject* Scene::getGameObject(uint64_t instanceID)
+		{
+			Core::GameObject* result = resolve(getHandle(instanceID));
+			if (result == nullptr)
+				std::cout << "Couldn't find gameObject\n";
+			return result;
+		}
+
+		GameObjectHandle Scene::getHandle(uint64_t instanceID) const
+		{
+			const auto it = instanceIndex.find(instanceID);
+			return it != instanceIndex.end() ? it->second : 0;
+		}
+
+		Core::GameObject* Scene::resolve(GameObjectHandle handle) const
+		{
+			uint32_t const index = (uint32_t)handle;
+			uint32_t const generation = (uint32_t)(handle >> 32);
+			if (index >= slots.size() || slots[index].generation != generation)
+				return nullptr;
+			return slots[index].gameObject;
+		}
+
+		Core::Transform* Scene::getTransform(uint64_t instanceID) const
+		{
+			const auto it = transformIndex.find(instanceID);
+			return it != transformIndex.end() ? it->second : nullptr;
+		}
+
+		void Scene::addToIndex(Core::GameObject* gameObj)
+		{
+			uint32_t index;
+			if (!freeSlots.empty())
 			{
-				if (gameObjects[i]->getInstanceID() == instanceID) return gameObjects[i].get();
+				index = freeSlots.back();
+				freeSlots.pop_back();
 			}
-			std::cout << "Couldn't find gameObject\n";
-			return nullptr;
+			else
+			{
+				index = (uint32_t)slots.size();
+				slots.push_back({});
+			}
+
+			slots[index].gameObject = gameObj;
+			gameObj->sceneSlot = index;
+
+			//GameObjects that are deserialized from the same file more than once (e.g. prefabs) share their instanceIDs, the copies get new ones
+			Core::Transform* transform = gameObj->transform.get();
+			if (instanceIndex.count(gameObj->getID()) != 0)
+				gameObj->instanceID = Core::TObject::generateInstanceID();
+			if (transformIndex.count(transform->getID()) != 0)
+				transform->instanceID = Core::TObject::generateInstanceID();
+
+			instanceIndex[gameObj->getID()] = (GameObjectHandle)slots[index].generation << 32 | index;
+			transformIndex[transform->getID()] = transform;
+		}
+
+		void Scene::removeFromIndex(Core::GameObject* gameObj)
+		{
+			uint32_t const index = gameObj->sceneSlot;
+			if (index >= slots.size() || slots[index].gameObject != gameObj)
+				return;
+
+			//Bumping the generation invalidates all existing handles to this slot
+			GameObjectHandle const handle = (GameObjectHandle)slots[index].generation << 32 | index;
+			slots[index].gameObject = nullptr;
+			gameObj->sceneSlot = UINT32_MAX;
+			slots[index].generation++;
+			if (slots[index].generation == 0)
+				slots[index].generation = 1;
+			freeSlots.push_back(index);
+
+			//Only the entries that still refer to this GameObject are removed, its IDs might have changed since it was added
+			const auto it = instanceIndex.find(gameObj->getID());
+			if (it != instanceIndex.end() && it->second == handle)
+				instanceIndex.erase(it);
+			const auto transformIt = transformIndex.find(gameObj->transform.get()->getID());
+			if (transformIt != transformIndex.end() && transformIt->second == gameObj->transform.get())
+				transformIndex.erase(transformIt);
 		}
 	}
 }
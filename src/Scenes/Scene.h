@@ -2,47 +2,180 @@
 #include "Core/TObject.h"
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include "Core/GameObject.h"
+#include "PrefabTemplate.h"
+#include "Misc/MemoryTracker.h"
 
 namespace Tristeon
 {
 	namespace Scenes
 	{
+		/**
+		 * A generational handle to a GameObject in a scene. The lower 32 bits are a slot index, the upper 32 bits the generation of that slot.
+		 * Handles to removed GameObjects turn invalid instead of referring to whichever GameObject reuses the slot. 0 is never a valid handle.
+		 */
+		using GameObjectHandle = uint64_t;
+
 		/**
 		 * Scenes contain everything inside of your level/game. From environments to characters, physics bodies etc.
 		 * A scene object can exist without it being loaded in. If you wish to manually create a scene and load it in after, use SceneManager::loadScene(scene);
 		 */
-		class Scene final : public Core::TObject
+		class Scene final : public Core::TObject, public Misc::Tracked<Misc::MEM_SCENE>
 		{
 			friend SceneManager;
+			friend BinaryScene;
 		public:
 			/**
-			 * Adds the GameObject to the scene and reserializes it to set its values back to their defaults.
+			 * Adds the GameObject to the scene.
 			 * Required to pass a unique_ptr as Scene takes over ownership of the given GameObject.
 			 * Will automatically initialize the GameObject if the scene's already loaded.
 			 */
 			void addGameObject(std::unique_ptr<Core::GameObject> gameObj);
 
 			/**
-			 * Removes the GameObject from the scene. 
+			 * Removes the GameObject from the scene in constant time, the last GameObject of the scene takes its place.
 			 * The GameObject automatically gets destroyed. 
 			 * Any references to the GameObject will automatically turn invalid.
 			 */
 			void removeGameObject(Core::GameObject* gameObj);
 
 			/**
-			 * Returns the first GameObject in the list with the given instanceID. 
+			 * Creates count instances of the prefab and adds them to the scene. Instances are cloned from the in-memory template,
+			 * reusing previously destroyed instances of the prefab and their components where possible.
+			 * \param transforms Optional array of count transforms, one for each instance. The prefab's transform is used if null.
+			 * \return The new instances, in order
+			 */
+			std::vector<Core::GameObject*> instantiate(PrefabTemplate* prefab, size_t count, const InstanceTransform* transforms = nullptr);
+			/**
+			 * Creates an instance of the prefab and adds it to the scene. See instantiate(prefab, count, transforms).
+			 */
+			Core::GameObject* instantiate(PrefabTemplate* prefab, const InstanceTransform* transform = nullptr);
+
+			/**
+			 * Marks the GameObject for destruction. It stays alive until the end of the frame,
+			 * at which point all destroyed GameObjects are removed from the scene in a single pass.
+			 * Instances of prefabs are kept by their PrefabTemplate to be reused.
+			 */
+			void destroy(Core::GameObject* gameObj);
+
+			/**
+			 * Returns the GameObject with the given (serialized) instanceID.
 			 * Will return nullptr if no GO is found.
 			 */
 			Core::GameObject* getGameObject(std::string instanceID);
+			/**
+			 * Returns the GameObject with the given instanceID in constant time.
+			 * Will return nullptr if no GO is found.
+			 */
+			Core::GameObject* getGameObject(uint64_t instanceID);
+
+			/**
+			 * Returns a handle to the GameObject with the given instanceID. 0 if no GO is found.
+			 */
+			GameObjectHandle getHandle(uint64_t instanceID) const;
+			/**
+			 * Returns the GameObject the handle refers to, nullptr if the GameObject has been removed.
+			 */
+			Core::GameObject* resolve(GameObjectHandle handle) const;
+
+			/**
+			 * Returns the transform with the given instanceID in constant time. Nullptr if no transform is found.
+			 */
+			Core::Transform* getTransform(uint64_t instanceID) const;
+
+			/**
+			 * Calls f(T&, Others&...) for every gameobject that has a component of type T and components of all the Others types.
+			 * Iterates linearly over the component pools of T, the Others are looked up on the gameobject of each T.
+			 * Put the rarest component type first to visit the least amount of components.
+			 *
+			 * Component pools are shared by every scene, this iterates over all live components regardless of which scene they belong to.
+			 */
+			template <typename T, typename... Others, typename F>
+			static void forEach(F f);
 
 			nlohmann::json serialize() override;
 			void deserialize(nlohmann::json json) override;
+			/**
+			 * Creates the GameObjects of a streamed scene file as soon as they've been parsed.
+			 * Their components are initialized by init(), once the whole scene has been loaded.
+			 */
+			bool deserializeElement(const std::string& arrayKey, nlohmann::json& element) override;
 		private:
 			void init();
+			/**
+			 * Removes all the GameObjects that have been marked by destroy() from the scene, keeping the order of the others intact
+			 */
+			void flushDestroyed();
+			/**
+			 * Creates a GameObject from its serialized data and adds it to the scene.
+			 * If initComponents is false, its components aren't initialized until the GameObject is.
+			 */
+			void loadGameObject(nlohmann::json data, bool initComponents = true);
+			/**
+			 * Adds the GameObject to the end of the scene's list of GameObjects and to the instanceID indices
+			 */
+			void pushGameObject(std::unique_ptr<Core::GameObject> gameObj);
+
+			/**
+			 * Assigns a handle to the GameObject and adds it and its transform to the instanceID indices
+			 */
+			void addToIndex(Core::GameObject* gameObj);
+			/**
+			 * Invalidates the handle of the GameObject and removes it and its transform from the instanceID indices
+			 */
+			void removeFromIndex(Core::GameObject* gameObj);
 
 			std::vector<std::unique_ptr<Tristeon::Core::GameObject>> gameObjects;
+			/**
+			 * The amount of GameObjects that have been marked by destroy() since the last flush
+			 */
+			size_t destroyedCount = 0;
+
+			struct Slot
+			{
+				Core::GameObject* gameObject = nullptr;
+				uint32_t generation = 1;
+				/**
+				 * The index of the GameObject in gameObjects
+				 */
+				uint32_t position = 0;
+			};
+			std::vector<Slot> slots;
+			std::vector<uint32_t> freeSlots;
+			/**
+			 * Maps the instanceID of every GameObject in the scene to its handle
+			 */
+			std::unordered_map<uint64_t, GameObjectHandle> instanceIndex;
+			/**
+			 * Maps the instanceID of the transform of every GameObject in the scene to the transform, used to link parents
+			 */
+			std::unordered_map<uint64_t, Core::Transform*> transformIndex;
 			REGISTER_TYPE_H(Scene)
 		};
+
+		template <typename T, typename ... Others, typename F>
+		void Scene::forEach(F f)
+		{
+			auto call = [&f](T* component, auto*... others)
+			{
+				//Skip the gameobject if any of the other components is missing
+				bool found[] = { true, (others != nullptr)... };
+				for (bool const b : found)
+				{
+					if (!b)
+						return;
+				}
+				f(*component, *others...);
+			};
+
+			Core::Components::ComponentPool::forEach<T>([&call](T* component)
+			{
+				Core::GameObject* go = component->gameObject.get();
+				if (go->pooled)
+					return;
+				call(component, go->template getComponent<Others>()...);
+			});
+		}
 	}
 }
\ No newline at end of file
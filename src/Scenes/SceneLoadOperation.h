@@ -0,0 +1,89 @@
+﻿#pragma once
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Editor/json.hpp"
+#include "Data/Mesh.h"
+#include "Scene.h"
+
+namespace Tristeon
+{
+	namespace Scenes
+	{
+		class SceneManager;
+
+		/**
+		 * SceneLoadOperation describes the progress of a scene that is being loaded through SceneManager::loadSceneAsync().
+		 * The operation stays valid after the load has finished, it can be polled from any thread.
+		 */
+		class SceneLoadOperation final
+		{
+			friend SceneManager;
+		public:
+			/**
+			 * Returns the progress of the load, ranging from 0 to 1
+			 */
+			float getProgress() const { return progress.load(); }
+			/**
+			 * Returns true once the scene has been loaded and initialized, or once the load has failed or has been cancelled
+			 */
+			bool isDone() const { return done.load(); }
+			/**
+			 * Returns true if the scene couldn't be loaded, or if the load has been cancelled by loading another scene
+			 */
+			bool hasFailed() const { return failed.load(); }
+			/**
+			 * The name of the scene that is being loaded
+			 */
+			const std::string& getSceneName() const { return sceneName; }
+		private:
+			enum Stage
+			{
+				/**
+				 * The file is being read and parsed, and its meshes are being loaded, on a worker thread
+				 */
+				LS_READING,
+				/**
+				 * The GameObjects are being created on the main thread
+				 */
+				LS_CREATING,
+				/**
+				 * The scene is active, its GameObjects are being initialized on the main thread
+				 */
+				LS_INITIALIZING
+			};
+
+			std::string sceneName;
+			std::string path;
+
+			std::atomic<float> progress { 0 };
+			std::atomic<bool> done { false };
+			std::atomic<bool> failed { false };
+			/**
+			 * Set by the worker thread once everything below has been filled in
+			 */
+			std::atomic<bool> read { false };
+			/**
+			 * Set by the main thread, tells the worker thread to stop early
+			 */
+			std::atomic<bool> cancelled { false };
+
+			/**
+			 * Written by the worker thread, owned by the main thread once read is true
+			 */
+			std::string name;
+			std::vector<nlohmann::json> gameObjectData;
+			std::vector<std::string> meshPaths;
+			std::vector<std::unique_ptr<Data::Mesh>> meshes;
+
+			/**
+			 * Only accessed by the main thread
+			 */
+			Stage stage = LS_READING;
+			std::unique_ptr<Scene> scene;
+			std::vector<GameObjectHandle> uninitialized;
+			size_t next = 0;
+		};
+	}
+}
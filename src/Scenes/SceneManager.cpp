@@ -4,6 +4,14 @@
 #include "Scene.h"
 #include "Core/Rendering/Components/MeshRenderer.h"
 #include "Editor/JsonSerializer.h"
+#include "BinaryScene.h"
+#include "Core/JobSystem.h"
+#include "Data/MeshBatch.h"
+#include "Misc/Profiler.h"
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <set>
+namespace filesystem = boost::filesystem;
 
 namespace Tristeon
 {
@@ -11,6 +19,66 @@ namespace Tristeon
 	{
 		std::unique_ptr<Scene> SceneManager::activeScene = nullptr;
 		std::map<std::string, std::string> SceneManager::sceneFilePaths;
+		std::shared_ptr<SceneLoadOperation> SceneManager::pendingLoad;
+		double SceneManager::loadTimeBudget = 0.008;
+
+		namespace
+		{
+			/**
+			 * Collects the serialized GameObjects of a scene file while it's being streamed, without creating them
+			 */
+			struct SceneFileReader : Serializable
+			{
+				std::string name;
+				std::vector<nlohmann::json> gameObjects;
+
+				bool deserializeElement(const std::string& arrayKey, nlohmann::json& element) override
+				{
+					if (arrayKey != "gameObjects")
+						return false;
+					gameObjects.push_back(std::move(element));
+					return true;
+				}
+
+				void deserialize(nlohmann::json json) override
+				{
+					if (json["name"].is_string())
+					{
+						const std::string nameValue = json["name"];
+						name = nameValue;
+					}
+				}
+			};
+
+			/**
+			 * Returns the paths of the mesh files used by the MeshRenderers in the serialized GameObjects
+			 */
+			std::vector<std::string> findMeshPaths(const std::vector<nlohmann::json>& gameObjects, const std::set<std::string>& loaded)
+			{
+				std::set<std::string> paths;
+				for (const nlohmann::json& gameObject : gameObjects)
+				{
+					const auto components = gameObject.find("components");
+					if (components == gameObject.end() || !components->is_array())
+						continue;
+
+					for (const nlohmann::json& component : *components)
+					{
+						const auto meshPath = component.find("meshPath");
+						if (meshPath != component.end() && meshPath->is_string())
+							paths.insert(meshPath->get<std::string>());
+					}
+				}
+
+				std::vector<std::string> result;
+				for (const std::string& path : paths)
+				{
+					if (loaded.find(path) == loaded.end() && filesystem::exists(path))
+						result.push_back(path);
+				}
+				return result;
+			}
+		}
 
 		SceneManager::SceneManager()
 		{
@@ -42,10 +110,24 @@ namespace Tristeon
 
 		void SceneManager::loadScene(std::string name)
 		{
+			TRISTEON_PROFILE_SCOPE("SceneManager::loadScene");
+			cancelLoading();
 			Core::MessageBus::sendMessage(Core::MT_MANAGER_RESET);
 
-			//Attempt to deserialize scene from file
-			auto const scene = JsonSerializer::deserialize<Scene>(sceneFilePaths[name]);
+			//Attempt to load the binary version of the scene, fall back to the json file if it's missing or outdated
+			std::string const path = sceneFilePaths[name];
+			std::string const binaryPath = BinaryScene::getBinaryPath(path);
+			Scene* scene = nullptr;
+			boost::system::error_code error;
+			if (filesystem::exists(binaryPath, error) && (!filesystem::exists(path, error) || filesystem::last_write_time(binaryPath, error) >= filesystem::last_write_time(path, error)))
+				scene = BinaryScene::load(binaryPath);
+			if (!scene)
+			{
+				//Stream the json file, GameObjects are created while it's being parsed instead of after building the whole document
+				std::unique_ptr<Scene> streamed = std::make_unique<Scene>();
+				if (JsonSerializer::stream(path, *streamed))
+					scene = streamed.release();
+			}
 			if (!scene)
             {
                 Misc::Console::warning("Couldn't load scene " + std::string(sceneFilePaths[name]));
@@ -57,20 +139,167 @@ namespace Tristeon
 
 		void SceneManager::loadScene(Scene* scene)
 		{
+			cancelLoading();
 			Core::MessageBus::sendMessage(Core::MT_MANAGER_RESET);
 			scene->init();
 			activeScene = std::unique_ptr<Scene>(scene);
 			createParentalBonds(activeScene.get());
 		}
 
-		Core::Transform* SceneManager::findTransformByInstanceID(std::string instanceID)
+		std::shared_ptr<SceneLoadOperation> SceneManager::loadSceneAsync(std::string name)
+		{
+			cancelLoading();
+
+			std::shared_ptr<SceneLoadOperation> operation = std::make_shared<SceneLoadOperation>();
+			operation->sceneName = name;
+			operation->path = sceneFilePaths[name];
+			pendingLoad = operation;
+
+			//The worker can't access the mesh batch, tell it which meshes are loaded already
+			std::set<std::string> loadedMeshes;
+			for (const auto& pair : Data::MeshBatch::loadedMeshes)
+				loadedMeshes.insert(pair.first);
+
+			//The read can take many frames, it must not end up in the main thread's queue where any wait() on the main thread could pick it up
+			Core::JobSystem::scheduleBackground([operation, loadedMeshes]()
+			{
+				//Nothing in here may touch the engine's state, GameObjects and components are created on the main thread
+				try
+				{
+					SceneFileReader reader;
+					if (!JsonSerializer::stream(operation->path, reader))
+					{
+						operation->failed = true;
+						operation->read.store(true, std::memory_order_release);
+						return;
+					}
+					operation->name = reader.name;
+					operation->gameObjectData = std::move(reader.gameObjects);
+					operation->progress = 0.1f;
+
+					operation->meshPaths = findMeshPaths(operation->gameObjectData, loadedMeshes);
+					operation->meshes.resize(operation->meshPaths.size());
+					std::atomic<size_t> loaded { 0 };
+					Core::JobSystem::parallelFor(operation->meshPaths.size(), 1, [&](size_t begin, size_t end)
+					{
+						for (size_t i = begin; i < end && !operation->cancelled; i++)
+						{
+							operation->meshes[i] = std::make_unique<Data::Mesh>();
+							operation->meshes[i]->load(operation->meshPaths[i]);
+							operation->progress = 0.1f + 0.15f * float(++loaded) / float(operation->meshPaths.size());
+						}
+					});
+				}
+				catch (const std::exception& e)
+				{
+					Misc::Console::warning("Couldn't load scene " + operation->path + ": " + e.what());
+					operation->failed = true;
+				}
+				operation->progress = 0.25f;
+				operation->read.store(true, std::memory_order_release);
+			});
+			return operation;
+		}
+
+		void SceneManager::updateLoading()
 		{
-			for (int i = 0; i < activeScene->gameObjects.size(); ++i)
+			if (!pendingLoad || !pendingLoad->read.load(std::memory_order_acquire))
+				return;
+			TRISTEON_PROFILE_SCOPE("SceneManager::updateLoading");
+
+			SceneLoadOperation& operation = *pendingLoad;
+			if (operation.failed)
+			{
+				Misc::Console::warning("Couldn't load scene " + operation.path);
+				finishLoading(true);
+				return;
+			}
+
+			using clock = std::chrono::steady_clock;
+			const clock::time_point deadline = clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(loadTimeBudget));
+
+			if (operation.stage == SceneLoadOperation::LS_READING)
+			{
+				//Hand over the meshes that were loaded by the workers
+				for (size_t i = 0; i < operation.meshes.size(); i++)
+				{
+					if (operation.meshes[i])
+						Data::MeshBatch::addMesh(operation.meshPaths[i], std::move(operation.meshes[i]));
+				}
+				operation.meshes.clear();
+
+				operation.scene = std::make_unique<Scene>();
+				operation.scene->name = operation.name;
+				size_t const count = operation.gameObjectData.size();
+				operation.scene->gameObjects.reserve(count);
+				operation.scene->slots.reserve(count);
+				operation.scene->instanceIndex.reserve(count);
+				operation.scene->transformIndex.reserve(count);
+				operation.stage = SceneLoadOperation::LS_CREATING;
+			}
+
+			if (operation.stage == SceneLoadOperation::LS_CREATING)
 			{
-				if (activeScene->gameObjects[i]->transform.get()->getInstanceID() == instanceID)
-					return activeScene->gameObjects[i].get()->transform.get();
+				//Deserializing a GameObject may load its materials and textures, which can only be done on the main thread.
+				//Components aren't initialized yet, they would register themselves and run alongside the current scene.
+				std::vector<nlohmann::json>& data = operation.gameObjectData;
+				while (operation.next < data.size() && clock::now() < deadline)
+				{
+					operation.scene->loadGameObject(std::move(data[operation.next]), false);
+					operation.next++;
+				}
+				operation.progress = 0.25f + 0.5f * (data.empty() ? 1.0f : float(operation.next) / float(data.size()));
+				if (operation.next < data.size())
+					return;
+
+				//Every GameObject exists, activate the scene and initialize its GameObjects from here on
+				Core::MessageBus::sendMessage(Core::MT_MANAGER_RESET);
+				activeScene = std::move(operation.scene);
+				createParentalBonds(activeScene.get());
+
+				for (const std::unique_ptr<Core::GameObject>& gameObject : activeScene->gameObjects)
+					operation.uninitialized.push_back(activeScene->getHandle(gameObject->getID()));
+				operation.next = 0;
+				operation.stage = SceneLoadOperation::LS_INITIALIZING;
 			}
-			return nullptr;
+
+			//Handles are used because the scene can be modified in between frames
+			std::vector<GameObjectHandle>& uninitialized = operation.uninitialized;
+			//The components initialized this frame register themselves in a single batch
+			Core::MessageBus::Batch batch;
+			while (operation.next < uninitialized.size() && clock::now() < deadline)
+			{
+				Core::GameObject* gameObject = activeScene->resolve(uninitialized[operation.next]);
+				if (gameObject != nullptr)
+					gameObject->init();
+				operation.next++;
+			}
+			operation.progress = 0.75f + 0.25f * (uninitialized.empty() ? 1.0f : float(operation.next) / float(uninitialized.size()));
+
+			if (operation.next == uninitialized.size())
+				finishLoading(false);
+		}
+
+		void SceneManager::cancelLoading()
+		{
+			if (!pendingLoad)
+				return;
+			pendingLoad->cancelled = true;
+			finishLoading(true);
+		}
+
+		void SceneManager::finishLoading(bool failed)
+		{
+			pendingLoad->failed = failed;
+			if (!failed)
+				pendingLoad->progress = 1.0f;
+			pendingLoad->done = true;
+
+			//The worker might still be running, in which case it still owns the data it's reading into
+			pendingLoad->scene.reset();
+			if (pendingLoad->read.load(std::memory_order_acquire))
+				pendingLoad->gameObjectData.clear();
+			pendingLoad.reset();
 		}
 
 		void SceneManager::createParentalBonds(Scene* scene)
@@ -78,12 +307,12 @@ namespace Tristeon
 			std::vector<std::unique_ptr<Core::GameObject>>& gameObjects = scene->gameObjects;
 			for (int i = 0; i < gameObjects.size(); ++i)
 			{
-				auto parent = gameObjects[i]->transform.get()->parentID;
+				Core::Transform* transform = gameObjects[i]->transform.get();
 				//Does gameobject have a parent?
-				if (parent != "null")
+				if (transform->parentID != 0)
 				{
 					//Find and set the parent
-					gameObjects[i]->transform.get()->setParent(findTransformByInstanceID(parent));
+					transform->setParent(scene->getTransform(transform->parentID), false);
 				}
 			}
 		}
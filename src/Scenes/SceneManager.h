@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <string>
 #include "Scene.h"
+#include "SceneLoadOperation.h"
 
 #ifdef TRISTEON_EDITOR
 #include "Editor/Asset Browser/SceneFileitem.h"
@@ -45,6 +46,19 @@ namespace Tristeon
 			 */
 			static void loadScene(Scene* scene);
 
+			/**
+			 * Loads a scene based on the given scene name in the background. The current scene stays active until the new scene is ready.
+			 * The file is read and parsed on the job system's background thread, its meshes are loaded by the workers. GameObjects are created and initialized on the main thread,
+			 * spread out over multiple frames so that loading never takes up more than the load time budget of a frame.
+			 * Loading any other scene cancels the asynchronous load. If the load fails, the current scene remains active.
+			 * \return The operation, which can be used to track the progress of the load
+			 */
+			static std::shared_ptr<SceneLoadOperation> loadSceneAsync(std::string name);
+			/**
+			 * Sets the maximum amount of time that asynchronous scene loading may take up on the main thread per frame, in milliseconds.
+			 */
+			static void setLoadTimeBudget(float milliseconds) { loadTimeBudget = milliseconds / 1000.0; }
+
 			/**
 			 * The current active scene. This value will never be null after engine initialization.
 			 */
@@ -53,14 +67,40 @@ namespace Tristeon
 			SceneManager();
 			~SceneManager() { activeScene.reset(); }
 
-			static Core::Transform* findTransformByInstanceID(std::string instanceID);
+			/**
+			 * Links every transform in the scene to its parent in one pass, using the scene's transform index.
+			 * The deserialized values are local already, so the world transform isn't kept.
+			 */
 			static void createParentalBonds(Scene* scene);
 
+			/**
+			 * Continues the asynchronous load, if any, for as long as the load time budget allows. Called once per frame by the engine.
+			 */
+			static void updateLoading();
+			/**
+			 * Removes the GameObjects that have been destroyed during this frame from the active scene. Called at the end of every frame by the engine.
+			 */
+			static void flushDestroyed() { if (activeScene) activeScene->flushDestroyed(); }
+			/**
+			 * Cancels the asynchronous load, if any. The scene it was loading is destroyed.
+			 */
+			static void cancelLoading();
+			/**
+			 * Ends the asynchronous load, if any, and marks it as done
+			 */
+			static void finishLoading(bool failed);
+
 			static void addScenePath(std::string name, std::string path);
 			static void removeScenePath(std::string name) { sceneFilePaths.erase(name); }
 
 			static std::map<std::string,std::string> sceneFilePaths;
 			static std::unique_ptr<Scene> activeScene;
+
+			static std::shared_ptr<SceneLoadOperation> pendingLoad;
+			/**
+			 * In seconds
+			 */
+			static double loadTimeBudget;
 		};
 	}
 }